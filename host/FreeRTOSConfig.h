@@ -0,0 +1,95 @@
+/*
+ * Configuração do FreeRTOS para o build de host (port POSIX).
+ * Segue lib/FreeRTOSConfig.h em tudo que o firmware usa; difere só no que é
+ * do RP2040 (interop do SDK, SMP, tickless) e no tamanho mínimo de pilha.
+ */
+
+ #ifndef FREERTOS_CONFIG_H
+ #define FREERTOS_CONFIG_H
+
+ #include "pico/stdlib.h"   /* time_us_32() do mock para as estatísticas */
+
+ /* Scheduler Related */
+ #define configUSE_PREEMPTION                    1
+ #define configUSE_TICKLESS_IDLE                 0
+ #define configUSE_IDLE_HOOK                     0
+ #define configUSE_TICK_HOOK                     0
+ #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
+ #define configMAX_PRIORITIES                    32
+ #define configMINIMAL_STACK_SIZE                ( configSTACK_DEPTH_TYPE ) 1024
+ #define configUSE_16_BIT_TICKS                  0
+
+ #define configIDLE_SHOULD_YIELD                 1
+
+ /* Synchronization Related */
+ #define configUSE_MUTEXES                       1
+ #define configUSE_RECURSIVE_MUTEXES             1
+ #define configUSE_APPLICATION_TASK_TAG          0
+ #define configUSE_COUNTING_SEMAPHORES           1
+ #define configQUEUE_REGISTRY_SIZE               8
+ #define configUSE_QUEUE_SETS                    1
+ #define configUSE_TIME_SLICING                  1
+ #define configUSE_NEWLIB_REENTRANT              0
+ #define configENABLE_BACKWARD_COMPATIBILITY     0
+ #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+ #define configTASK_NOTIFICATION_ARRAY_ENTRIES   2
+
+ /* System */
+ #define configSTACK_DEPTH_TYPE                  uint32_t
+ #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
+
+ /* Memory allocation related definitions. */
+ /* Mesmo perfil só estático do firmware */
+ #define configSUPPORT_STATIC_ALLOCATION         1
+ #define configSUPPORT_DYNAMIC_ALLOCATION        0
+ #define configKERNEL_PROVIDED_STATIC_MEMORY     1
+ #define configAPPLICATION_ALLOCATED_HEAP        0
+
+ /* Hook function related definitions. */
+ #define configCHECK_FOR_STACK_OVERFLOW          0
+ #define configUSE_MALLOC_FAILED_HOOK            0
+ #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+
+ /* Run time and task stats gathering related definitions. */
+ #define configGENERATE_RUN_TIME_STATS           1
+ #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+ #define portGET_RUN_TIME_COUNTER_VALUE()        time_us_32()
+ #define configUSE_TRACE_FACILITY                1
+ #define configUSE_STATS_FORMATTING_FUNCTIONS    0
+
+ /* Co-routine related definitions. */
+ #define configUSE_CO_ROUTINES                   0
+ #define configMAX_CO_ROUTINE_PRIORITIES         1
+
+ /* Software timer related definitions. A prioridade máxima fica para a
+    task de IRQ simulada do sim_main.c */
+ #define configUSE_TIMERS                        1
+ #define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 2 )
+ #define configTIMER_QUEUE_LENGTH                10
+ #define configTIMER_TASK_STACK_DEPTH            1024
+
+ /* Um núcleo simulado */
+ #define configNUM_CORES                         1
+ #define configNUMBER_OF_CORES                   1
+
+ #include <assert.h>
+ #define configASSERT(x)                         assert(x)
+
+ #define INCLUDE_vTaskPrioritySet                1
+ #define INCLUDE_uxTaskPriorityGet               1
+ #define INCLUDE_vTaskDelete                     1
+ #define INCLUDE_vTaskSuspend                    1
+ #define INCLUDE_vTaskDelayUntil                 1
+ #define INCLUDE_vTaskDelay                      1
+ #define INCLUDE_xTaskGetSchedulerState          1
+ #define INCLUDE_xTaskGetCurrentTaskHandle       1
+ #define INCLUDE_uxTaskGetStackHighWaterMark     1
+ #define INCLUDE_xTaskGetIdleTaskHandle          1
+ #define INCLUDE_eTaskGetState                   1
+ #define INCLUDE_xTimerPendFunctionCall          1
+ #define INCLUDE_xTaskAbortDelay                 1
+ #define INCLUDE_xTaskGetHandle                  1
+ #define INCLUDE_xTaskResumeFromISR              1
+ #define INCLUDE_xQueueGetMutexHolder            1
+
+ #endif /* FREERTOS_CONFIG_H */
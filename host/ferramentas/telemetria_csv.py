@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Decodifica a telemetria binária do painel (tecla 'b') em CSV.
+
+Quadros COBS delimitados por 0x00: [tipo][seq][payload][crc16 LE], com
+CRC-16/CCITT-FALSE sobre tipo, seq e payload (telemetria_bin.h). O texto do
+printf que chega intercalado no mesmo CDC é descartado ao ressincronizar no
+zero seguinte; quadros com CRC ruim são contados e ignorados.
+
+Uso: python3 telemetria_csv.py [--tipo ocupacao|task|latencia|display] [entrada]
+  entrada: arquivo ou porta já em modo raw (ex.: /dev/ttyACM0 depois de
+  'stty -F /dev/ttyACM0 raw'); sem ela, lê o stdin. CSV no stdout e um
+  resumo (quadros, erros de CRC, perdas pela seq) no stderr.
+"""
+import argparse
+import csv
+import struct
+import sys
+
+# Espelham zonas_cfg e etapa_latencia_t em main.c
+ZONAS = ['Sala', 'Audit', 'Patio']
+ETAPAS = ['Entrada', 'Reset', 'Despacho', 'Render', 'OLED', 'Matriz', 'Carga']
+
+# tipo: (nome, formato struct do payload, colunas)
+TIPOS = {
+    1: ('ocupacao', '<IBHHIII',
+        ['ts_ms', 'zona', 'ocupacao', 'capacidade', 'entradas', 'saidas', 'recusas']),
+    2: ('task', '<IBBHH12s',
+        ['ts_ms', 'numero', 'prioridade', 'cpu_pct', 'pilha_livre', 'nome']),
+    3: ('latencia', '<IBIIII',
+        ['ts_ms', 'etapa', 'amostras', 'p50_us', 'p99_us', 'max_us']),
+    # flush_em_curso não vem no quadro: é calculada em linha_csv
+    4: ('display', '<IIIIIIII',
+        ['ts_ms', 'comandos', 'fundidos', 'quadros', 'sobrepostos',
+         'flush_iniciados', 'flush_concluidos', 'flush_cancelados', 'flush_em_curso']),
+}
+
+
+def crc16(dados):
+    crc = 0xFFFF
+    for b in dados:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decodificar(dados):
+    saida = bytearray()
+    i = 0
+    while i < len(dados):
+        codigo = dados[i]
+        if codigo == 0 or i + codigo > len(dados) + 1:
+            return None
+        saida += dados[i + 1:i + codigo]
+        i += codigo
+        if codigo < 0xFF and i < len(dados):
+            saida.append(0)
+    return bytes(saida)
+
+
+def quadros(fluxo):
+    """Gera os trechos entre zeros, lendo aos poucos (serve para porta serial)."""
+    pendente = bytearray()
+    while True:
+        bloco = fluxo.read1(4096) if hasattr(fluxo, 'read1') else fluxo.read(4096)
+        if not bloco:
+            break
+        pendente += bloco
+        *prontos, resto = pendente.split(b'\x00')
+        pendente = bytearray(resto)
+        for q in prontos:
+            if q:
+                yield bytes(q)
+
+
+def linha_csv(tipo, campos):
+    d = dict(zip(TIPOS[tipo][2], campos))
+    if tipo == 1:
+        z = d['zona']
+        d['zona'] = ZONAS[z] if z < len(ZONAS) else z
+    elif tipo == 2:
+        d['cpu_pct'] = '%.1f' % (d['cpu_pct'] / 10)
+        d['nome'] = d['nome'].split(b'\x00', 1)[0].decode('ascii', 'replace')
+    elif tipo == 3:
+        e = d['etapa']
+        d['etapa'] = ETAPAS[e] if e < len(ETAPAS) else e
+    elif tipo == 4:
+        d['flush_em_curso'] = (d['flush_iniciados'] - d['flush_concluidos']) & 0xFFFFFFFF
+    return d
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('--tipo', choices=[t[0] for t in TIPOS.values()], default='ocupacao')
+    ap.add_argument('entrada', nargs='?')
+    args = ap.parse_args()
+
+    tipo_csv = next(k for k, v in TIPOS.items() if v[0] == args.tipo)
+    escritor = csv.DictWriter(sys.stdout, ['seq'] + TIPOS[tipo_csv][2], lineterminator='\n')
+    escritor.writeheader()
+
+    validos = crc_ruim = perdidos = 0
+    seq_anterior = None
+    fluxo = open(args.entrada, 'rb', buffering=0) if args.entrada else sys.stdin.buffer
+    try:
+        for bruto in quadros(fluxo):
+            q = cobs_decodificar(bruto)
+            if q is None or len(q) < 4:
+                continue  # Texto intercalado ou lixo: não é quadro
+            if crc16(q[:-2]) != struct.unpack('<H', q[-2:])[0]:
+                crc_ruim += 1
+                continue
+            tipo, seq, payload = q[0], q[1], q[2:-2]
+            if tipo not in TIPOS or len(payload) != struct.calcsize(TIPOS[tipo][1]):
+                crc_ruim += 1
+                continue
+            validos += 1
+            if seq_anterior is not None:
+                perdidos += (seq - seq_anterior - 1) & 0xFF
+            seq_anterior = seq
+            if tipo == tipo_csv:
+                d = linha_csv(tipo, struct.unpack(TIPOS[tipo][1], payload))
+                d['seq'] = seq
+                escritor.writerow(d)
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    print('quadros=%d crc_ruim=%d perdidos=%d' % (validos, crc_ruim, perdidos), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,4 @@
+#ifndef MOCK_HARDWARE_ADC_H
+#define MOCK_HARDWARE_ADC_H
+#include "pico/stdlib.h"
+#endif
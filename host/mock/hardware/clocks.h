@@ -0,0 +1,6 @@
+#ifndef MOCK_HARDWARE_CLOCKS_H
+#define MOCK_HARDWARE_CLOCKS_H
+#include "pico/stdlib.h"
+enum clock_index { clk_gpout0 = 0, clk_ref = 4, clk_sys = 5, clk_peri = 6 };
+static inline uint32_t clock_get_hz(enum clock_index clk) { (void)clk; return 125000000u; }
+#endif
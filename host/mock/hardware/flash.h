@@ -0,0 +1,17 @@
+#ifndef MOCK_HARDWARE_FLASH_H
+#define MOCK_HARDWARE_FLASH_H
+#include "pico/stdlib.h"
+
+/* Flash QSPI de 2 MB simulada num vetor; XIP_BASE aponta para ele, então a
+   leitura "mapeada" do firmware funciona igual. Programar só limpa bits
+   (como na NOR): gravar sobre área não apagada dá o AND dos dois valores */
+#define FLASH_PAGE_SIZE         (1u << 8)
+#define FLASH_SECTOR_SIZE       (1u << 12)
+#define PICO_FLASH_SIZE_BYTES   (2u * 1024u * 1024u)
+
+extern uint8_t mock_flash[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE                ((uintptr_t)mock_flash)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+#endif
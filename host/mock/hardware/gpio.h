@@ -0,0 +1,4 @@
+#ifndef MOCK_HARDWARE_GPIO_H
+#define MOCK_HARDWARE_GPIO_H
+#include "pico/stdlib.h"   // GPIO declarado junto do stdlib no mock
+#endif
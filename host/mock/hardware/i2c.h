@@ -0,0 +1,26 @@
+#ifndef MOCK_HARDWARE_I2C_H
+#define MOCK_HARDWARE_I2C_H
+#include "pico/stdlib.h"
+
+/* Registradores usados pelo driver do SSD1306; o FIFO do mock esvazia na hora.
+   TX_ABRT só sobe com mock_i2c_nack(); a leitura de clr_tx_abrt não o limpa
+   aqui, quem limpa é o próximo envio por DMA sem NACK. */
+typedef struct {
+    volatile uint32_t enable, tar, data_cmd, status, raw_intr_stat, clr_tx_abrt;
+} i2c_hw_t;
+typedef struct i2c_inst { i2c_hw_t *hw; bool restart_on_next; } i2c_inst_t;
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+#define I2C_IC_DATA_CMD_STOP_BITS        0x200u
+#define I2C_IC_DATA_CMD_RESTART_BITS     0x400u
+#define I2C_IC_STATUS_TFE_BITS           0x04u
+#define I2C_IC_STATUS_MST_ACTIVITY_BITS  0x20u
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS 0x40u
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int  i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) { return i2c->hw; }
+static inline uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) { return (i2c == i2c0 ? 32u : 34u) + !is_tx; }
+#endif
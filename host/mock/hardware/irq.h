@@ -0,0 +1,11 @@
+#ifndef MOCK_HARDWARE_IRQ_H
+#define MOCK_HARDWARE_IRQ_H
+#include "pico/stdlib.h"
+#define DMA_IRQ_0                                        11
+#define DMA_IRQ_1                                        12
+#define IO_IRQ_BANK0                                     13
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY   0x80
+typedef void (*irq_handler_t)(void);
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_set_enabled(uint num, bool enabled);
+#endif
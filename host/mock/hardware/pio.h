@@ -0,0 +1,37 @@
+#ifndef MOCK_HARDWARE_PIO_H
+#define MOCK_HARDWARE_PIO_H
+#include "pico/stdlib.h"
+
+/* Só o FIFO TX importa: o mock entrega cada palavra ao modelo da matriz */
+typedef struct { volatile uint32_t txf[4]; } pio_hw_t;
+typedef pio_hw_t *PIO;
+extern pio_hw_t pio0_hw_inst, pio1_hw_inst;
+#define pio0 (&pio0_hw_inst)
+#define pio1 (&pio1_hw_inst)
+
+typedef struct pio_program {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+    uint8_t pio_version;
+    uint32_t used_gpio_ranges;
+} pio_program_t;
+
+typedef struct { uint32_t clkdiv, execctrl, shiftctrl, pinctrl; } pio_sm_config;
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE = 0, PIO_FIFO_JOIN_TX = 1, PIO_FIFO_JOIN_RX = 2 };
+
+static inline pio_sm_config pio_get_default_sm_config(void) { pio_sm_config c = {0}; return c; }
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) { (void)c; (void)wrap_target; (void)wrap; }
+static inline void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) { (void)c; (void)bit_count; (void)optional; (void)pindirs; }
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint base) { (void)c; (void)base; }
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool right, bool autopull, uint threshold) { (void)c; (void)right; (void)autopull; (void)threshold; }
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) { (void)c; (void)join; }
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) { (void)c; (void)div; }
+static inline void pio_gpio_init(PIO pio, uint pin) { (void)pio; (void)pin; }
+static inline void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin, uint count, bool out) { (void)pio; (void)sm; (void)pin; (void)count; (void)out; }
+static inline void pio_sm_init(PIO pio, uint sm, uint offset, const pio_sm_config *c) { (void)pio; (void)sm; (void)offset; (void)c; }
+static inline void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) { (void)pio; (void)sm; (void)enabled; }
+static inline uint pio_add_program(PIO pio, const pio_program_t *program) { (void)pio; (void)program; return 0; }
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { return (pio == pio0 ? 0u : 8u) + sm + (is_tx ? 0u : 4u); }
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+#endif
@@ -0,0 +1,10 @@
+#ifndef MOCK_HARDWARE_PWM_H
+#define MOCK_HARDWARE_PWM_H
+#include "pico/stdlib.h"
+static inline uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1u) & 7u; }
+static inline uint pwm_gpio_to_channel(uint gpio) { return gpio & 1u; }
+static inline void pwm_set_clkdiv(uint slice, float div) { (void)slice; (void)div; }
+static inline void pwm_set_wrap(uint slice, uint16_t wrap) { (void)slice; (void)wrap; }
+static inline void pwm_set_chan_level(uint slice, uint chan, uint16_t level) { (void)slice; (void)chan; (void)level; }
+void pwm_set_enabled(uint slice, bool enabled);   // Registrado: liga/desliga do buzzer
+#endif
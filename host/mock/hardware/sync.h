@@ -0,0 +1,15 @@
+#ifndef MOCK_HARDWARE_SYNC_H
+#define MOCK_HARDWARE_SYNC_H
+#include "pico/stdlib.h"
+
+/* No host as "IRQs" rodam na task de IRQ simulada: desabilitar interrupções
+   vira uma seção crítica do FreeRTOS (sem troca de task até o restore) */
+uint32_t save_and_disable_interrupts(void);
+void     restore_interrupts(uint32_t status);
+
+typedef volatile uint32_t spin_lock_t;
+int          spin_lock_claim_unused(bool required);
+spin_lock_t *spin_lock_init(uint lock_num);
+uint32_t     spin_lock_blocking(spin_lock_t *lock);
+void         spin_unlock(spin_lock_t *lock, uint32_t saved_irq);
+#endif
@@ -0,0 +1,4 @@
+#ifndef MOCK_HARDWARE_TIMER_H
+#define MOCK_HARDWARE_TIMER_H
+#include "pico/stdlib.h"   // time_us_32/64 e alarmes declarados no stdlib do mock
+#endif
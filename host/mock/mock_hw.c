@@ -0,0 +1,486 @@
+#include "mock_hw.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hardware/dma.h"
+#include "hardware/flash.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include "pico/flash.h"
+
+#define NUM_GPIOS        30
+#define NUM_CANAIS_DMA   12
+#define NUM_ALARMES      8
+#define NUM_HANDLERS     4
+#define US_POR_BYTE_I2C  22.5    // 9 bits a 400 kHz
+#define US_POR_LED       30u     // 24 bits a 800 kHz
+
+static mock_trafego_t trafego;
+
+/* ---------- Tempo ---------- */
+static struct timespec inicio;
+
+uint64_t time_us_64(void) {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (uint64_t)(agora.tv_sec - inicio.tv_sec) * 1000000u
+         + (uint64_t)((agora.tv_nsec - inicio.tv_nsec) / 1000);
+}
+
+void sleep_us(uint64_t us) {
+    struct timespec t = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000 };
+    nanosleep(&t, NULL);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+void panic(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fputs("*** PANIC ***\n", stderr);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    abort();
+}
+
+/* ---------- Interrupções ---------- */
+uint32_t save_and_disable_interrupts(void) {
+    taskENTER_CRITICAL();
+    return 0;
+}
+
+void restore_interrupts(uint32_t status) {
+    (void)status;
+    taskEXIT_CRITICAL();
+}
+
+static spin_lock_t travas[32];
+static uint32_t    travas_usadas;
+
+int spin_lock_claim_unused(bool required) {
+    for (int i = 0; i < 32; ++i)
+        if (!(travas_usadas & (1u << i))) { travas_usadas |= 1u << i; return i; }
+    (void)required;
+    return -1;
+}
+
+spin_lock_t *spin_lock_init(uint lock_num) {
+    travas[lock_num] = 0;
+    return &travas[lock_num];
+}
+
+uint32_t spin_lock_blocking(spin_lock_t *lock) {
+    uint32_t irq = save_and_disable_interrupts();
+    *lock = 1;
+    return irq;
+}
+
+void spin_unlock(spin_lock_t *lock, uint32_t saved_irq) {
+    *lock = 0;
+    restore_interrupts(saved_irq);
+}
+
+static irq_handler_t handlers_dma[NUM_HANDLERS];
+static bool          irq_dma_habilitada;
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    if (num != DMA_IRQ_0) return;
+    for (int i = 0; i < NUM_HANDLERS; ++i)
+        if (handlers_dma[i] == NULL) { handlers_dma[i] = handler; return; }
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (num == DMA_IRQ_0) irq_dma_habilitada = enabled;
+}
+
+/* ---------- Alarmes ---------- */
+typedef struct {
+    bool ativo;
+    uint64_t quando_us;
+    alarm_callback_t cb;
+    void *dados;
+} alarme_t;
+
+static alarme_t alarmes[NUM_ALARMES];
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    (void)fire_if_past;
+    uint32_t irq = save_and_disable_interrupts();
+    alarm_id_t id = -1;
+    for (int i = 0; i < NUM_ALARMES; ++i) {
+        if (!alarmes[i].ativo) {
+            alarmes[i] = (alarme_t){ true, time_us_64() + us, callback, user_data };
+            id = i + 1;
+            break;
+        }
+    }
+    restore_interrupts(irq);
+    return id;
+}
+
+/* ---------- Modelo do SSD1306 ---------- */
+static struct {
+    uint8_t ram[MOCK_OLED_PAGINAS][MOCK_OLED_LARGURA];
+    bool    ligado;
+    uint8_t col0, col1, pag0, pag1, col, pag;
+    bool    primeiro;            // próximo byte é o de controle da transação
+    bool    dados;               // D/C# da transação atual
+    uint8_t cmd, args[2], nargs, faltam;
+} oled;
+
+static void oled_inicio(void) {
+    oled.primeiro = true;
+    oled.faltam = 0;
+    ++trafego.i2c_transacoes;
+}
+
+static void oled_comando(uint8_t b) {
+    if (oled.faltam) {
+        oled.args[oled.nargs++] = b;
+        if (--oled.faltam) return;
+        if (oled.cmd == 0x21) {
+            oled.col0 = oled.args[0] & 0x7F; oled.col1 = oled.args[1] & 0x7F; oled.col = oled.col0;
+        } else if (oled.cmd == 0x22) {
+            oled.pag0 = oled.args[0] & 0x07; oled.pag1 = oled.args[1] & 0x07; oled.pag = oled.pag0;
+        }
+        return;
+    }
+
+    oled.cmd = b;
+    oled.nargs = 0;
+    switch (b) {
+        case 0x21: case 0x22:
+            oled.faltam = 2; break;
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            oled.faltam = 1; break;
+        case 0xAE: oled.ligado = false; break;
+        case 0xAF: oled.ligado = true;  break;
+        default: break;
+    }
+}
+
+static void oled_byte(uint8_t b) {
+    ++trafego.i2c_bytes;
+    if (oled.primeiro) {
+        oled.primeiro = false;
+        oled.dados = (b & 0x40) != 0;
+        return;
+    }
+    if (!oled.dados) {
+        oled_comando(b);
+        return;
+    }
+
+    /* Endereçamento horizontal dentro da janela 0x21/0x22 */
+    oled.ram[oled.pag][oled.col] = b;
+    if (oled.col++ >= oled.col1) {
+        oled.col = oled.col0;
+        oled.pag = (oled.pag >= oled.pag1) ? oled.pag0 : oled.pag + 1;
+    }
+}
+
+/* ---------- I2C ---------- */
+static i2c_hw_t i2c0_hw_regs = { .status = I2C_IC_STATUS_TFE_BITS };
+static i2c_hw_t i2c1_hw_regs = { .status = I2C_IC_STATUS_TFE_BITS };
+i2c_inst_t i2c0_inst = { &i2c0_hw_regs, false };
+i2c_inst_t i2c1_inst = { &i2c1_hw_regs, false };
+
+static bool i2c_nack;   // Display "ausente": envios por DMA abortam
+
+void mock_i2c_nack(bool ativo) { i2c_nack = ativo; }
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->hw->enable = 1;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)nostop;
+    oled_inicio();
+    for (size_t i = 0; i < len; ++i) oled_byte(src[i]);
+    return (int)len;
+}
+
+/* ---------- PIO / cadeia WS2812 ---------- */
+pio_hw_t pio0_hw_inst, pio1_hw_inst;
+static uint32_t matriz[MOCK_MATRIZ_LEDS];
+static uint     matriz_idx;
+
+static void matriz_palavra(uint32_t w) {
+    matriz[matriz_idx++] = w;
+    if (matriz_idx == MOCK_MATRIZ_LEDS) {
+        matriz_idx = 0;
+        ++trafego.quadros_matriz;
+    }
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    (void)pio; (void)sm;
+    matriz_palavra(data);
+}
+
+/* ---------- DMA ---------- */
+typedef struct {
+    bool usado, ocupado, irq0, status;
+    uint tamanho;
+    volatile void *destino;
+    uint64_t fim_us;
+} canal_dma_t;
+
+static canal_dma_t canais[NUM_CANAIS_DMA];
+
+int dma_claim_unused_channel(bool required) {
+    for (int i = 0; i < NUM_CANAIS_DMA; ++i)
+        if (!canais[i].usado) { canais[i].usado = true; return i; }
+    (void)required;
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    dma_channel_config c = { DMA_SIZE_32 | (1u << 2) };
+    return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->ctrl = (c->ctrl & ~3u) | (uint32_t)size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? (c->ctrl | (1u << 2)) : (c->ctrl & ~(1u << 2));
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void)c; (void)dreq; }
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    canais[channel].tamanho = config->ctrl & 3u;
+    canais[channel].destino = write_addr;
+    if (trigger) dma_channel_transfer_from_buffer_now(channel, read_addr, transfer_count);
+}
+
+/* O conteúdo é entregue ao modelo no início; o fim (e a IRQ) vem depois do
+   tempo que o barramento real levaria */
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    canal_dma_t *c = &canais[channel];
+    double duracao_us = 0;
+
+    if (c->destino == &i2c1_hw_regs.data_cmd || c->destino == &i2c0_hw_regs.data_cmd) {
+        i2c_hw_t *hw = c->destino == &i2c1_hw_regs.data_cmd ? &i2c1_hw_regs : &i2c0_hw_regs;
+        if (i2c_nack) {
+            // NACK no endereço: o FIFO é descartado e o DREQ não volta
+            hw->raw_intr_stat |= I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+            c->ocupado = true;
+            c->fim_us  = UINT64_MAX;
+            return;
+        }
+        hw->raw_intr_stat &= ~I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+        const volatile uint16_t *w = read_addr;
+        bool novo = true;
+        for (uint32_t i = 0; i < transfer_count; ++i) {
+            if (novo) oled_inicio();
+            oled_byte((uint8_t)w[i]);
+            novo = (w[i] & I2C_IC_DATA_CMD_STOP_BITS) != 0;
+        }
+        ++trafego.dma_oled;
+        duracao_us = transfer_count * US_POR_BYTE_I2C;
+    } else {
+        const volatile uint32_t *w = read_addr;
+        for (uint32_t i = 0; i < transfer_count; ++i) matriz_palavra(w[i]);
+        duracao_us = (double)transfer_count * US_POR_LED;
+    }
+
+    c->ocupado = true;
+    c->fim_us  = time_us_64() + (uint64_t)duracao_us;
+}
+
+bool dma_channel_is_busy(uint channel)                     { return canais[channel].ocupado; }
+void dma_channel_abort(uint channel)                       { canais[channel].ocupado = false; }
+void dma_channel_set_irq0_enabled(uint channel, bool en)   { canais[channel].irq0 = en; }
+bool dma_channel_get_irq0_status(uint channel)             { return canais[channel].status; }
+void dma_channel_acknowledge_irq0(uint channel)            { canais[channel].status = false; }
+
+/* ---------- GPIO e PWM ---------- */
+static bool                nivel[NUM_GPIOS];
+static uint32_t            eventos_irq[NUM_GPIOS];
+static gpio_irq_callback_t cb_gpio;
+static bool                pwm_ativo[8];
+
+void gpio_init(uint gpio)                                  { nivel[gpio] = false; }
+void gpio_set_dir(uint gpio, bool out)                     { (void)gpio; (void)out; }
+void gpio_pull_up(uint gpio)                               { nivel[gpio] = true; }
+bool gpio_get(uint gpio)                                   { return nivel[gpio]; }
+void gpio_set_function(uint gpio, enum gpio_function fn)   { (void)gpio; (void)fn; }
+
+void gpio_put(uint gpio, bool value) {
+    if (nivel[gpio] == value) return;
+    nivel[gpio] = value;
+    ++trafego.transicoes_gpio;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    if (enabled) eventos_irq[gpio] |= event_mask;
+    else         eventos_irq[gpio] &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+    cb_gpio = callback;
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+}
+
+void pwm_set_enabled(uint slice, bool enabled) {
+    if (enabled && !pwm_ativo[slice]) ++trafego.buzzer_ligado;
+    pwm_ativo[slice] = enabled;
+}
+
+/* ---------- stdio ---------- */
+static char   entrada[64];
+static uint   entrada_ini, entrada_fim;
+static void (*cb_stdio)(void *);
+static void  *cb_stdio_param;
+
+bool stdio_init_all(void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    (void)timeout_us;
+    if (entrada_ini == entrada_fim) return PICO_ERROR_TIMEOUT;
+    return (unsigned char)entrada[entrada_ini++ % sizeof(entrada)];
+}
+
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation) {
+    (void)cr_translation;   // stdout do host não traduz
+    fwrite(s, 1, (size_t)len, stdout);
+    if (newline) putchar('\n');
+    fflush(stdout);
+    return len;
+}
+
+void stdio_set_chars_available_callback(void (*fn)(void *), void *param) {
+    cb_stdio = fn;
+    cb_stdio_param = param;
+}
+
+/* ---------- Flash ---------- */
+uint8_t mock_flash[PICO_FLASH_SIZE_BYTES];
+
+static void flash_conferir(uint32_t offs, size_t count, uint32_t alinhamento) {
+    if (offs % alinhamento || count % alinhamento || offs + count > PICO_FLASH_SIZE_BYTES) {
+        fprintf(stderr, "mock: acesso à flash desalinhado (0x%lx, %zu)\n", (unsigned long)offs, count);
+        abort();
+    }
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    flash_conferir(flash_offs, count, FLASH_SECTOR_SIZE);
+    memset(&mock_flash[flash_offs], 0xFF, count);
+    trafego.flash_apagados += count / FLASH_SECTOR_SIZE;
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    flash_conferir(flash_offs, count, FLASH_PAGE_SIZE);
+    for (size_t i = 0; i < count; ++i) mock_flash[flash_offs + i] &= data[i];
+    trafego.flash_gravados += count;
+}
+
+bool mock_flash_carregar(const char *caminho) {
+    FILE *f = fopen(caminho, "rb");
+    if (f == NULL) return false;
+    const bool ok = fread(mock_flash, 1, sizeof(mock_flash), f) == sizeof(mock_flash);
+    fclose(f);
+    return ok;
+}
+
+bool mock_flash_salvar(const char *caminho) {
+    FILE *f = fopen(caminho, "wb");
+    if (f == NULL) return false;
+    const bool ok = fwrite(mock_flash, 1, sizeof(mock_flash), f) == sizeof(mock_flash);
+    return fclose(f) == 0 && ok;
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    (void)enter_exit_timeout_ms;
+    uint32_t irq = save_and_disable_interrupts();
+    func(param);
+    restore_interrupts(irq);
+    return PICO_OK;
+}
+
+/* ---------- Controle e inspeção ---------- */
+void mock_hw_init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    memset(&trafego, 0, sizeof(trafego));
+    memset(mock_flash, 0xFF, sizeof(mock_flash));
+    memset(&oled, 0, sizeof(oled));
+    oled.col1 = MOCK_OLED_LARGURA - 1;
+    oled.pag1 = MOCK_OLED_PAGINAS - 1;
+}
+
+void mock_hw_processar(void) {
+    const uint64_t agora = time_us_64();
+
+    bool irq_dma = false;
+    for (int i = 0; i < NUM_CANAIS_DMA; ++i) {
+        canal_dma_t *c = &canais[i];
+        if (!c->ocupado || c->fim_us > agora) continue;
+        c->ocupado = false;
+        if (c->irq0) { c->status = true; irq_dma = true; }
+    }
+    if (irq_dma && irq_dma_habilitada)
+        for (int i = 0; i < NUM_HANDLERS && handlers_dma[i]; ++i) handlers_dma[i]();
+
+    for (int i = 0; i < NUM_ALARMES; ++i) {
+        alarme_t *a = &alarmes[i];
+        if (!a->ativo || a->quando_us > agora) continue;
+        a->ativo = false;
+        int64_t repetir = a->cb(i + 1, a->dados);
+        if (repetir > 0) { a->quando_us += (uint64_t)repetir; a->ativo = true; }
+    }
+}
+
+void mock_gpio_borda(uint gpio, bool novo_nivel) {
+    if (nivel[gpio] == novo_nivel) return;
+    nivel[gpio] = novo_nivel;
+    uint32_t evento = novo_nivel ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+    if (cb_gpio && (eventos_irq[gpio] & evento)) cb_gpio(gpio, evento);
+}
+
+void mock_stdio_entrada(char c) {
+    if (entrada_fim - entrada_ini >= sizeof(entrada)) return;  // Cheio: byte perdido, como num FIFO
+    entrada[entrada_fim++ % sizeof(entrada)] = c;
+    if (cb_stdio) cb_stdio(cb_stdio_param);
+}
+
+const mock_trafego_t *mock_trafego(void) { return &trafego; }
+bool mock_gpio_nivel(uint gpio)           { return nivel[gpio]; }
+bool mock_oled_ligado(void)               { return oled.ligado; }
+const uint32_t *mock_matriz_quadro(void)  { return matriz; }
+
+bool mock_oled_pixel(uint x, uint y) {
+    return (oled.ram[y / 8][x] >> (y % 8)) & 1u;
+}
+
+bool mock_oled_gravar_pbm(const char *caminho) {
+    FILE *f = fopen(caminho, "w");
+    if (f == NULL) return false;
+    fprintf(f, "P1\n%d %d\n", MOCK_OLED_LARGURA, MOCK_OLED_PAGINAS * 8);
+    for (uint y = 0; y < MOCK_OLED_PAGINAS * 8; ++y) {
+        for (uint x = 0; x < MOCK_OLED_LARGURA; ++x) fputc(mock_oled_pixel(x, y) ? '1' : '0', f);
+        fputc('\n', f);
+    }
+    return fclose(f) == 0;
+}
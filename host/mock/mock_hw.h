@@ -0,0 +1,47 @@
+#ifndef MOCK_HW_H
+#define MOCK_HW_H
+
+#include "pico/stdlib.h"
+
+/* ---------- Periféricos simulados do build de host ----------
+ * Os headers de pico/ e hardware/ deste diretório substituem os do SDK.
+ * O tráfego de I2C, DMA, PIO, GPIO e PWM é contado e alimenta modelos do
+ * SSD1306 (GDDRAM + comandos de janela) e da cadeia WS2812; a flash é um
+ * vetor de 2 MB. As "IRQs"
+ * (fim de DMA, alarmes, bordas de GPIO, bytes no stdio) são entregues por
+ * mock_hw_processar()/mock_gpio_borda()/mock_stdio_entrada(), chamadas da
+ * task de IRQ simulada do sim_main.c. */
+
+#define MOCK_OLED_LARGURA  128
+#define MOCK_OLED_PAGINAS  8
+#define MOCK_MATRIZ_LEDS   25
+
+typedef struct {
+    uint32_t i2c_transacoes;   // START..STOP, bloqueantes e por DMA
+    uint32_t i2c_bytes;        // bytes no barramento, sem o byte de endereço
+    uint32_t dma_oled;         // envios do OLED por DMA
+    uint32_t quadros_matriz;   // quadros completos entregues ao FIFO do PIO
+    uint32_t transicoes_gpio;  // mudanças de nível em pinos de saída
+    uint32_t buzzer_ligado;    // vezes que um slice PWM foi habilitado
+    uint32_t flash_apagados;   // setores de 4 KB apagados
+    uint32_t flash_gravados;   // bytes programados
+} mock_trafego_t;
+
+/* ---------- Controle ---------- */
+void mock_hw_init(void);                        // Zera modelos e marca o instante 0
+void mock_hw_processar(void);                   // Conclui DMAs e dispara alarmes vencidos
+void mock_gpio_borda(uint gpio, bool nivel);    // Muda uma entrada e chama a IRQ de GPIO
+void mock_stdio_entrada(char c);                // Byte recebido no stdio
+void mock_i2c_nack(bool ativo);                 // Envios por DMA ao I2C abortam (TX_ABRT) e não terminam
+bool mock_flash_carregar(const char *caminho);  // Imagem de 2 MB; false = arquivo ausente/curto
+bool mock_flash_salvar(const char *caminho);
+
+/* ---------- Inspeção ---------- */
+const mock_trafego_t *mock_trafego(void);
+bool            mock_gpio_nivel(uint gpio);
+bool            mock_oled_ligado(void);
+bool            mock_oled_pixel(uint x, uint y);
+bool            mock_oled_gravar_pbm(const char *caminho);  // GDDRAM → PBM (P1) 128×64
+const uint32_t *mock_matriz_quadro(void);                   // 25 palavras (GRB << 8), ordem da cadeia
+
+#endif /* MOCK_HW_H */
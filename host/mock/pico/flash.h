@@ -0,0 +1,7 @@
+#ifndef MOCK_PICO_FLASH_H
+#define MOCK_PICO_FLASH_H
+#include "pico/stdlib.h"
+
+/* Sem segundo núcleo nem XIP real: executa 'func' numa seção crítica */
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+#endif
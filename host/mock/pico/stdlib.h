@@ -0,0 +1,62 @@
+#ifndef MOCK_PICO_STDLIB_H
+#define MOCK_PICO_STDLIB_H
+
+/* ---------- Subconjunto do Pico SDK para o build de host ----------
+ * Mesmas assinaturas do SDK 2.1; a implementação (mock_hw.c) grava o
+ * tráfego e mantém modelos do OLED, da matriz e dos pinos. */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+
+/* ---------- Tempo (relógio monotônico do host, em µs desde o início) ---------- */
+typedef uint64_t absolute_time_t;
+uint64_t time_us_64(void);
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000u); }
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+
+void panic(const char *fmt, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+#define tight_loop_contents()        do {} while (0)
+#define __not_in_flash_func(f)       f
+#define __time_critical_func(f)      f
+#define count_of(a)                  (sizeof(a) / sizeof((a)[0]))
+
+/* ---------- stdio ---------- */
+#define PICO_OK                      0
+#define PICO_ERROR_TIMEOUT           (-1)
+bool stdio_init_all(void);
+int  getchar_timeout_us(uint32_t timeout_us);
+int  stdio_put_string(const char *s, int len, bool newline, bool cr_translation);
+void stdio_set_chars_available_callback(void (*fn)(void *), void *param);
+
+/* ---------- GPIO ---------- */
+#define GPIO_IN                      false
+#define GPIO_OUT                     true
+#define GPIO_IRQ_LEVEL_LOW           0x1u
+#define GPIO_IRQ_LEVEL_HIGH          0x2u
+#define GPIO_IRQ_EDGE_FALL           0x4u
+#define GPIO_IRQ_EDGE_RISE           0x8u
+enum gpio_function { GPIO_FUNC_I2C = 3, GPIO_FUNC_PWM = 4, GPIO_FUNC_PIO0 = 6, GPIO_FUNC_NULL = 0x1f };
+
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_pull_up(uint gpio);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled);
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback);
+
+#endif
@@ -0,0 +1,185 @@
+/* Build de host do painel: roda o main.c real sobre o port POSIX do FreeRTOS,
+   com os periféricos simulados de mock/ e entradas vindas de um roteiro.
+
+   Uso: painel_host <roteiro> [imagem_flash]
+
+   Com imagem_flash, a flash simulada é lida dela na partida (se existir) e
+   gravada de volta no fim: duas execuções seguidas simulam um reboot.
+
+   Roteiro: uma ação por linha, "<tempo_ms> <ação> [argumento]", com o tempo
+   contado desde o início; '#' começa um comentário.
+       100   A [ms]          aperto do botão A (entrada), solto após ms (padrão 100)
+       400   B [ms]          aperto do botão B (saída)
+       900   J [ms]          aperto do joystick (reset)
+       1500  tecla l         byte no stdio (t = telemetria, l = latências, z = zera)
+       1600  texto g50,0,0,2 linha no stdio, com '\n' no fim (sem espaços)
+       2000  quadro a.pbm    grava o OLED como PBM
+       2500  fim             relatório do tráfego e saída (implícito 1 s após a última ação) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mock_hw.h"
+
+/* Mesmos pinos do main.c */
+#define PINO_BTN_ENTRADA      5
+#define PINO_BTN_SAIDA        6
+#define PINO_JOYSTICK_RESET   22
+#define PINO_LED_VERDE        11
+#define PINO_LED_AZUL         12
+#define PINO_LED_VERMELHO     13
+
+#define APERTO_PADRAO_MS      100
+
+int painel_main(void);   // main() do firmware, renomeado pelo CMakeLists.txt
+
+typedef enum { EV_BORDA, EV_TECLA, EV_TEXTO, EV_QUADRO, EV_FIM } tipo_evento_t;
+
+typedef struct {
+    uint64_t      t_us;
+    uint32_t      ordem;          // desempate estável entre ações no mesmo instante
+    tipo_evento_t tipo;
+    uint          pino;
+    bool          nivel;
+    char          tecla;
+    char          arquivo[128];   // PBM do quadro ou linha do texto
+} evento_t;
+
+static evento_t *eventos;
+static size_t    num_eventos, cap_eventos;
+
+static evento_t *novo_evento(uint64_t t_ms, tipo_evento_t tipo) {
+    if (num_eventos == cap_eventos) {
+        cap_eventos = cap_eventos ? cap_eventos * 2 : 32;
+        eventos = realloc(eventos, cap_eventos * sizeof(*eventos));
+        if (eventos == NULL) { perror("realloc"); exit(2); }
+    }
+    evento_t *e = &eventos[num_eventos];
+    memset(e, 0, sizeof(*e));
+    e->t_us  = t_ms * 1000u;
+    e->ordem = (uint32_t)num_eventos++;
+    e->tipo  = tipo;
+    return e;
+}
+
+static void aperto(uint64_t t_ms, uint pino, uint64_t duracao_ms) {
+    evento_t *e = novo_evento(t_ms, EV_BORDA);
+    e->pino = pino; e->nivel = false;                       // pull-up: apertar = descida
+    e = novo_evento(t_ms + duracao_ms, EV_BORDA);
+    e->pino = pino; e->nivel = true;
+}
+
+static int comparar_eventos(const void *a, const void *b) {
+    const evento_t *x = a, *y = b;
+    if (x->t_us != y->t_us) return x->t_us < y->t_us ? -1 : 1;
+    return x->ordem < y->ordem ? -1 : 1;
+}
+
+static bool carregar_roteiro(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    if (f == NULL) { perror(caminho); return false; }
+
+    char linha[256];
+    unsigned n_linha = 0;
+    uint64_t ultimo_ms = 0;
+    bool tem_fim = false;
+
+    while (fgets(linha, sizeof(linha), f)) {
+        ++n_linha;
+        char *comentario = strchr(linha, '#');
+        if (comentario) *comentario = '\0';
+
+        unsigned long long t_ms;
+        char acao[32], arg[128] = "";
+        int campos = sscanf(linha, "%llu %31s %127s", &t_ms, acao, arg);
+        if (campos <= 0) continue;
+        if (campos < 2) { fprintf(stderr, "%s:%u: falta a ação\n", caminho, n_linha); fclose(f); return false; }
+
+        uint64_t dur = (campos == 3) ? strtoull(arg, NULL, 10) : APERTO_PADRAO_MS;
+        if      (!strcmp(acao, "A")) aperto(t_ms, PINO_BTN_ENTRADA, dur);
+        else if (!strcmp(acao, "B")) aperto(t_ms, PINO_BTN_SAIDA, dur);
+        else if (!strcmp(acao, "J")) aperto(t_ms, PINO_JOYSTICK_RESET, dur);
+        else if (!strcmp(acao, "tecla") && campos == 3) novo_evento(t_ms, EV_TECLA)->tecla = arg[0];
+        else if (!strcmp(acao, "texto") && campos == 3)
+            snprintf(novo_evento(t_ms, EV_TEXTO)->arquivo, sizeof(eventos->arquivo), "%s", arg);
+        else if (!strcmp(acao, "quadro") && campos == 3)
+            snprintf(novo_evento(t_ms, EV_QUADRO)->arquivo, sizeof(eventos->arquivo), "%s", arg);
+        else if (!strcmp(acao, "fim")) { novo_evento(t_ms, EV_FIM); tem_fim = true; }
+        else { fprintf(stderr, "%s:%u: ação inválida '%s'\n", caminho, n_linha, acao); fclose(f); return false; }
+
+        if (t_ms + dur > ultimo_ms) ultimo_ms = t_ms + dur;
+    }
+    fclose(f);
+
+    if (!tem_fim) novo_evento(ultimo_ms + 1000, EV_FIM);
+    qsort(eventos, num_eventos, sizeof(*eventos), comparar_eventos);
+    return true;
+}
+
+static void relatorio_final(void) {
+    const mock_trafego_t *t = mock_trafego();
+    printf("=== Simulacao encerrada em %llu ms ===\n", (unsigned long long)(time_us_64() / 1000u));
+    printf("i2c_transacoes=%lu\n",  (unsigned long)t->i2c_transacoes);
+    printf("i2c_bytes=%lu\n",       (unsigned long)t->i2c_bytes);
+    printf("oled_envios_dma=%lu\n", (unsigned long)t->dma_oled);
+    printf("matriz_quadros=%lu\n",  (unsigned long)t->quadros_matriz);
+    printf("gpio_transicoes=%lu\n", (unsigned long)t->transicoes_gpio);
+    printf("buzzer_acionamentos=%lu\n", (unsigned long)t->buzzer_ligado);
+    printf("flash_setores_apagados=%lu\n", (unsigned long)t->flash_apagados);
+    printf("flash_bytes_gravados=%lu\n", (unsigned long)t->flash_gravados);
+    printf("oled=%s\n", mock_oled_ligado() ? "ligado" : "desligado");
+    printf("led_rgb=%d%d%d\n", mock_gpio_nivel(PINO_LED_VERMELHO),
+           mock_gpio_nivel(PINO_LED_VERDE), mock_gpio_nivel(PINO_LED_AZUL));
+
+    const uint32_t *q = mock_matriz_quadro();
+    printf("matriz=");
+    for (int i = 0; i < MOCK_MATRIZ_LEDS; ++i) printf("%06lx%c", (unsigned long)(q[i] >> 8), i + 1 < MOCK_MATRIZ_LEDS ? ',' : '\n');
+}
+
+static const char *imagem_flash;   // NULL = flash só em memória
+
+/* "Controlador de interrupções": prioridade máxima, então nada o interrompe;
+   a cada tick entrega os fins de DMA, alarmes e ações vencidas do roteiro */
+static void task_irq(void *arg) {
+    size_t prox = 0;
+
+    while (1) {
+        mock_hw_processar();
+
+        const uint64_t agora = time_us_64();
+        while (prox < num_eventos && eventos[prox].t_us <= agora) {
+            const evento_t *e = &eventos[prox++];
+            switch (e->tipo) {
+                case EV_BORDA:  mock_gpio_borda(e->pino, e->nivel); break;
+                case EV_TECLA:  mock_stdio_entrada(e->tecla);       break;
+                case EV_TEXTO:
+                    for (const char *c = e->arquivo; *c; ++c) mock_stdio_entrada(*c);
+                    mock_stdio_entrada('\n');
+                    break;
+                case EV_QUADRO:
+                    if (!mock_oled_gravar_pbm(e->arquivo)) perror(e->arquivo);
+                    break;
+                case EV_FIM:
+                    relatorio_final();
+                    if (imagem_flash && !mock_flash_salvar(imagem_flash)) perror(imagem_flash);
+                    exit(0);
+            }
+        }
+        vTaskDelay(1);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && !carregar_roteiro(argv[1])) return 2;
+    imagem_flash = argc > 2 ? argv[2] : NULL;
+
+    mock_hw_init();
+    if (imagem_flash) mock_flash_carregar(imagem_flash);   // ausente = flash apagada
+
+    static StaticTask_t tcb_irq;
+    static StackType_t  pilha_irq[configMINIMAL_STACK_SIZE * 4];
+    xTaskCreateStatic(task_irq, "IRQ", configMINIMAL_STACK_SIZE * 4, NULL, configMAX_PRIORITIES - 1,
+                      pilha_irq, &tcb_irq);
+    return painel_main();   // Cria as tasks do painel e inicia o escalonador
+}
@@ -0,0 +1,101 @@
+/* Vazão do contador de admissão sem locks contra o desenho anterior
+   (semáforo contador de vagas + mutex da contagem), com 1..N threads na
+   mesma mistura de entradas e saídas. No host o desenho anterior usa
+   sem_t/pthread_mutex_t no lugar de xSemaphoreTake/xSemaphoreGive: os
+   objetos do FreeRTOS só podem ser usados por tasks do escalonador.
+   Uso: bench_vagas [operações por thread] */
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdlib.h>
+#include <time.h>
+#include "teste.h"
+#include "vagas.h"
+
+#define MAX_THREADS  8
+#define CAPACIDADE   10
+
+/* Desenho anterior: sem_vagas (contador) + mtx_usuarios (contagem) */
+typedef struct {
+    sem_t           vagas;
+    pthread_mutex_t mtx;
+    uint32_t        usuarios;
+} vagas_sem_t;
+
+static vagas_t     vagas;
+static vagas_sem_t vagas_sem;
+static uint32_t    operacoes = 2000000u;
+
+static bool sem_entrar(vagas_sem_t *v) {
+    if (sem_trywait(&v->vagas) != 0) return false;   // xSemaphoreTake(sem_vagas, 0)
+    pthread_mutex_lock(&v->mtx);
+    ++v->usuarios;
+    pthread_mutex_unlock(&v->mtx);
+    return true;
+}
+
+static bool sem_sair(vagas_sem_t *v) {
+    pthread_mutex_lock(&v->mtx);
+    const bool saiu = v->usuarios > 0;
+    if (saiu) {
+        --v->usuarios;
+        sem_post(&v->vagas);                         // xSemaphoreGive(sem_vagas)
+    }
+    pthread_mutex_unlock(&v->mtx);
+    return saiu;
+}
+
+static void *carga_atomica(void *arg) {
+    uint32_t s = (uint32_t)(uintptr_t)arg;
+    for (uint32_t i = 0; i < operacoes; ++i) {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        if (s & 1u) vagas_try_enter(&vagas); else vagas_exit(&vagas);
+    }
+    return NULL;
+}
+
+static void *carga_semaforo(void *arg) {
+    uint32_t s = (uint32_t)(uintptr_t)arg;
+    for (uint32_t i = 0; i < operacoes; ++i) {
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        if (s & 1u) sem_entrar(&vagas_sem); else sem_sair(&vagas_sem);
+    }
+    return NULL;
+}
+
+/* Milhões de operações por segundo com n threads */
+static double medir(void *(*carga)(void *), int n) {
+    pthread_t threads[MAX_THREADS];
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < n; ++i) pthread_create(&threads[i], NULL, carga, (void *)(uintptr_t)(0x9E3779B9u * (i + 1)));
+    for (int i = 0; i < n; ++i) pthread_join(threads[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    const double s = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+    return (double)operacoes * n / s / 1e6;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) operacoes = (uint32_t)strtoul(argv[1], NULL, 10);
+
+    printf("%-8s %14s %14s %8s\n", "Threads", "Atomico Mop/s", "Semaforo Mop/s", "Razao");
+    for (int n = 1; n <= MAX_THREADS; n *= 2) {
+        vagas_init(&vagas, CAPACIDADE);
+        sem_init(&vagas_sem.vagas, 0, CAPACIDADE);
+        pthread_mutex_init(&vagas_sem.mtx, NULL);
+        vagas_sem.usuarios = 0;
+
+        const double atomico  = medir(carga_atomica, n);
+        const double semaforo = medir(carga_semaforo, n);
+        printf("%-8d %14.1f %14.1f %7.2fx\n", n, atomico, semaforo, atomico / semaforo);
+
+        // Os dois desenhos terminam consistentes: nunca acima da capacidade
+        int livres;
+        sem_getvalue(&vagas_sem.vagas, &livres);
+        CONFERIR(vagas_ocupacao(&vagas) <= CAPACIDADE);
+        CONFERIR_IGUAL(vagas_sem.usuarios + (uint32_t)livres, CAPACIDADE);
+
+        sem_destroy(&vagas_sem.vagas);
+        pthread_mutex_destroy(&vagas_sem.mtx);
+    }
+    return teste_fim("bench_vagas");
+}
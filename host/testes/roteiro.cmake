@@ -0,0 +1,49 @@
+#Roda um roteiro no painel_host e confere o relatório e os quadros do OLED
+#   cmake -DSIM=<painel_host> -DROTEIRO=<roteiro.txt> -DESPERADO=<esperado/nome>
+#         -DSAIDA=<diretório de trabalho> -P roteiro.cmake
+#<esperado>.txt tem linhas chave=valor que o relatório deve conter;
+#cada <esperado>/*.pbm deve ser idêntico ao quadro de mesmo nome gravado
+#pelo roteiro
+file(REMOVE_RECURSE ${SAIDA})
+file(MAKE_DIRECTORY ${SAIDA})
+execute_process(COMMAND ${SIM} ${ROTEIRO}
+    WORKING_DIRECTORY ${SAIDA}
+    OUTPUT_VARIABLE saida
+    RESULT_VARIABLE rc
+    TIMEOUT 120)
+file(WRITE ${SAIDA}/relatorio.txt "${saida}")
+if (NOT rc EQUAL 0)
+    message(FATAL_ERROR "${SIM} saiu com ${rc}")
+endif()
+
+set(falhas 0)
+set(saida "\n${saida}")
+file(STRINGS ${ESPERADO}.txt linhas ENCODING UTF-8)
+foreach(linha IN LISTS linhas)
+    if (linha MATCHES "^#" OR linha STREQUAL "")
+        continue()
+    endif()
+    string(FIND "${saida}" "\n${linha}\n" pos)
+    if (pos EQUAL -1)
+        string(REGEX MATCH "^[^=]*=" chave "${linha}")
+        string(REGEX MATCH "\n${chave}[^\n]*" obtido "${saida}")
+        string(STRIP "${obtido}" obtido)
+        message(SEND_ERROR "esperado '${linha}', obtido '${obtido}'")
+        math(EXPR falhas "${falhas} + 1")
+    endif()
+endforeach()
+
+file(GLOB quadros ${ESPERADO}/*.pbm)
+foreach(quadro IN LISTS quadros)
+    get_filename_component(nome ${quadro} NAME)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${quadro} ${SAIDA}/${nome}
+        RESULT_VARIABLE diferente)
+    if (diferente)
+        message(SEND_ERROR "quadro ${nome} difere de ${quadro}")
+        math(EXPR falhas "${falhas} + 1")
+    endif()
+endforeach()
+
+if (falhas GREATER 0)
+    message(FATAL_ERROR "${falhas} diferença(s); relatório completo em ${SAIDA}/relatorio.txt")
+endif()
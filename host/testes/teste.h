@@ -0,0 +1,33 @@
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <stdio.h>
+
+/* ---------- Verificações dos testes de host ----------
+ * CONFERIR registra a falha e segue, para um teste mostrar todas as
+ * divergências de uma vez; teste_fim() vira o código de saída do ctest. */
+static int teste_falhas;
+
+#define CONFERIR(cond) do {                                                   \
+        if (!(cond)) {                                                        \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+            ++teste_falhas;                                                   \
+        }                                                                     \
+    } while (0)
+
+#define CONFERIR_IGUAL(obtido, esperado) do {                                 \
+        const unsigned long long o_ = (obtido), e_ = (esperado);              \
+        if (o_ != e_) {                                                       \
+            fprintf(stderr, "%s:%d: %s = %llu, esperado %llu\n",              \
+                    __FILE__, __LINE__, #obtido, o_, e_);                     \
+            ++teste_falhas;                                                   \
+        }                                                                     \
+    } while (0)
+
+static inline int teste_fim(const char *nome) {
+    if (teste_falhas) fprintf(stderr, "%s: %d falha(s)\n", nome, teste_falhas);
+    else              printf("%s: ok\n", nome);
+    return teste_falhas ? 1 : 0;
+}
+
+#endif /* TESTE_H */
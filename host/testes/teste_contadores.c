@@ -0,0 +1,162 @@
+/* Contadores persistentes contra a flash simulada (mock_hw.c): acréscimo
+   sem apagar, compactação quando o setor enche, compactação cortada por
+   queda de energia (setor sem cabeçalho), registro cortado no meio e
+   releitura no boot, que nunca passa de um setor por mais gerações que o
+   anel já tenha dado. */
+#include <string.h>
+#include "teste.h"
+#include "mock_hw.h"
+#include "hardware/flash.h"
+#include "contadores.h"
+#include "layout_flash.h"
+
+#define REGISTROS_POR_SETOR  (FLASH_SECTOR_SIZE / 8)   // O 1º é o cabeçalho
+
+typedef struct {
+    uint8_t  chave;
+    uint8_t  verif;
+    uint16_t reservado;
+    uint32_t valor;
+} registro_t;   // Como em contadores.c
+
+static uint32_t esperados[CONTADORES_CHAVES];
+
+static uint32_t offset_setor(uint32_t s) { return CONTADORES_FLASH_INICIO + s * FLASH_SECTOR_SIZE; }
+
+static void definir(uint8_t chave, uint32_t valor) {
+    contadores_definir(chave, valor);
+    esperados[chave] = valor;
+}
+
+static bool valores_conferem(void) {
+    for (uint8_t k = 0; k < CONTADORES_CHAVES; ++k)
+        if (contadores_ler(k) != esperados[k]) {
+            fprintf(stderr, "chave %u = %lu, esperado %lu\n", k,
+                    (unsigned long)contadores_ler(k), (unsigned long)esperados[k]);
+            return false;
+        }
+    return true;
+}
+
+/* Persiste uma chave por vez até a próxima compactação */
+static void ate_compactar(uint8_t chave) {
+    contadores_stats_t st;
+    contadores_estatisticas(&st);
+    const uint32_t compactacoes = st.compactacoes;
+    while (st.compactacoes == compactacoes) {
+        definir(chave, esperados[chave] + 1);
+        contadores_persistir();
+        contadores_estatisticas(&st);
+    }
+}
+
+int main(void) {
+    mock_hw_init();
+    contadores_stats_t st;
+
+    // Região apagada: tudo zero, nenhuma geração
+    contadores_init();
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.geracao, 0);
+    CONFERIR(valores_conferem());
+    CONFERIR_IGUAL(contadores_persistir(), 0);   // Nada alterado, nada gravado
+    CONFERIR_IGUAL(mock_trafego()->flash_gravados, 0);
+
+    // Primeira gravação: compacta no setor 0 (geração 1)
+    definir(0, 5);
+    CONFERIR_IGUAL(contadores_persistir(), 1);
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.setor, 0);
+    CONFERIR_IGUAL(st.geracao, 1);
+    CONFERIR_IGUAL(mock_trafego()->flash_apagados, 1);
+
+    // Acréscimo: só registros novos, sem apagar
+    definir(1, 7);
+    definir(9, 123456789);
+    CONFERIR_IGUAL(contadores_persistir(), 2);
+    CONFERIR_IGUAL(contadores_persistir(), 0);
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.livres, REGISTROS_POR_SETOR - 1 - 3);
+    CONFERIR_IGUAL(mock_trafego()->flash_apagados, 1);
+
+    // Reboot: o último valor de cada chave vence
+    contadores_init();
+    CONFERIR(valores_conferem());
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.registros_lidos, 3);
+
+    // Setor cheio: compacta as chaves não nulas no setor seguinte
+    ate_compactar(1);
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.setor, 1);
+    CONFERIR_IGUAL(st.geracao, 2);
+    CONFERIR_IGUAL(st.livres, REGISTROS_POR_SETOR - 1 - 3);
+    CONFERIR_IGUAL(mock_trafego()->flash_apagados, 2);
+    contadores_init();
+    CONFERIR(valores_conferem());
+
+    // Registro cortado no meio de um acréscimo: verificação não bate, é ignorado
+    contadores_estatisticas(&st);
+    const uint32_t pos = REGISTROS_POR_SETOR - st.livres;
+    const uint32_t pag = pos * sizeof(registro_t) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+    uint8_t pagina[FLASH_PAGE_SIZE];
+    memset(pagina, 0xFF, sizeof(pagina));
+    registro_t *cortado = (registro_t *)&pagina[pos * sizeof(registro_t) - pag];
+    cortado->chave = 3;
+    cortado->verif = 0;
+    cortado->valor = 0xDEAD;
+    flash_range_program(offset_setor(st.setor) + pag, pagina, FLASH_PAGE_SIZE);
+    contadores_init();
+    CONFERIR(valores_conferem());
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.registros_lidos, 3);
+    CONFERIR_IGUAL(st.livres, REGISTROS_POR_SETOR - 1 - 4);   // A posição cortada não é reusada
+    definir(3, 42);
+    CONFERIR_IGUAL(contadores_persistir(), 1);
+    contadores_init();
+    CONFERIR(valores_conferem());
+
+    // Compactação cortada: setor seguinte apagado e com registros, sem
+    // cabeçalho. O boot fica com o setor ativo; a próxima compactação o refaz.
+    contadores_estatisticas(&st);
+    const uint32_t ativo = st.setor, geracao = st.geracao;
+    const uint32_t destino = (ativo + 1) % CONTADORES_SETORES;
+    flash_range_erase(offset_setor(destino), FLASH_SECTOR_SIZE);
+    memset(pagina, 0xFF, sizeof(pagina));
+    ((registro_t *)pagina)[1] = (registro_t){ 0, 0, 0xFFFF, 999 };
+    flash_range_program(offset_setor(destino), pagina, FLASH_PAGE_SIZE);
+    contadores_init();
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.setor, ativo);
+    CONFERIR_IGUAL(st.geracao, geracao);
+    CONFERIR(valores_conferem());
+    ate_compactar(2);
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.setor, destino);
+    contadores_init();
+    CONFERIR(valores_conferem());
+
+    // Várias voltas no anel: o boot lê só o setor de geração mais alta
+    for (uint8_t k = 4; k < CONTADORES_CHAVES; ++k) definir(k, k * 1000u);
+    for (int i = 0; i < 2 * CONTADORES_SETORES; ++i) ate_compactar(i % CONTADORES_CHAVES);
+    contadores_estatisticas(&st);
+    CONFERIR(st.geracao > CONTADORES_SETORES);
+    contadores_init();
+    CONFERIR(valores_conferem());
+    contadores_estatisticas(&st);
+    CONFERIR(st.registros_lidos <= REGISTROS_POR_SETOR - 1);
+
+    // Pior caso do boot: setor ativo cheio até a última posição
+    while (st.livres > 0) {
+        definir(5, esperados[5] + 1);
+        contadores_persistir();
+        contadores_estatisticas(&st);
+    }
+    contadores_init();
+    CONFERIR(valores_conferem());
+    contadores_estatisticas(&st);
+    CONFERIR_IGUAL(st.registros_lidos, REGISTROS_POR_SETOR - 1);
+    CONFERIR_IGUAL(st.paginas, 0);   // A varredura não grava nada
+
+    return teste_fim("teste_contadores");
+}
@@ -0,0 +1,114 @@
+/* Log de eventos contra a flash simulada (mock_hw.c): anel cheio descarta e
+   conta, as posições do anel dão a volta sem perder a ordem, a região de
+   setores gira sobrescrevendo o mais antigo e um novo eventos_init (reboot)
+   continua depois do setor de sequência mais alta. O valor de cada evento é
+   o seu índice, então cada setor tem de conter uma faixa contínua. */
+#include "teste.h"
+#include "mock_hw.h"
+#include "hardware/flash.h"
+#include "eventos.h"
+#include "layout_flash.h"
+
+#define MAGICA  0x31545645u   // "EVT1", como em eventos.c
+
+typedef struct {
+    uint32_t magica;
+    uint32_t seq;
+    evento_t eventos[EVENTOS_POR_SETOR];
+} setor_t;
+
+static uint32_t indice;   // Valor do próximo evento aceito
+
+static const setor_t *setor(uint32_t i) {
+    return (const setor_t *)(XIP_BASE + EVENTOS_FLASH_INICIO + i * FLASH_SECTOR_SIZE);
+}
+
+/* Registra até n eventos; retorna quantos o anel aceitou */
+static uint32_t registrar(uint32_t n) {
+    uint32_t aceitos = 0;
+    for (uint32_t i = 0; i < n; ++i)
+        if (eventos_registrar(LOG_ENTRADA, 1, indice)) { ++indice; ++aceitos; }
+    return aceitos;
+}
+
+/* Setor gravado com a sequência s guarda os índices (s-1)*511 .. s*511-1 */
+static bool setor_confere(uint32_t i, uint32_t seq) {
+    const setor_t *s = setor(i);
+    if (s->magica != MAGICA || s->seq != seq) return false;
+    for (uint32_t k = 0; k < EVENTOS_POR_SETOR; ++k)
+        if (s->eventos[k].valor != (seq - 1) * EVENTOS_POR_SETOR + k ||
+            s->eventos[k].tipo != LOG_ENTRADA || s->eventos[k].zona != 1) return false;
+    return true;
+}
+
+int main(void) {
+    mock_hw_init();
+    eventos_stats_t st;
+
+    // Região apagada: começa no setor 0, sem sequência
+    eventos_init();
+    eventos_estatisticas(&st);
+    CONFERIR_IGUAL(st.seq, 0);
+
+    // Anel cheio sem drenagem: o excedente é recusado e contado
+    CONFERIR_IGUAL(registrar(EVENTOS_ANEL), EVENTOS_ANEL);
+    CONFERIR(!eventos_registrar(LOG_SAIDA, 0, 0));
+    CONFERIR(!eventos_registrar(LOG_SAIDA, 0, 0));
+    eventos_estatisticas(&st);
+    CONFERIR_IGUAL(st.descartados, 2);
+    CONFERIR_IGUAL(st.registrados, EVENTOS_ANEL);
+
+    // Drenagem: dois setores cheios vão à flash, o resto fica na RAM
+    CONFERIR_IGUAL(eventos_drenar(), EVENTOS_ANEL);
+    eventos_estatisticas(&st);
+    CONFERIR_IGUAL(st.setores, 2);
+    CONFERIR_IGUAL(st.na_pagina, EVENTOS_ANEL - 2 * EVENTOS_POR_SETOR);
+    CONFERIR(setor_confere(0, 1));
+    CONFERIR(setor_confere(1, 2));
+    CONFERIR_IGUAL(mock_trafego()->flash_apagados, 2);
+
+    // Anel liberado: aceita de novo; as posições dão a volta várias vezes
+    // e a região de setores gira até sobrescrever os três mais antigos
+    const uint32_t alvo = EVENTOS_SETORES + 3;
+    while (st.setores < alvo) {
+        registrar(EVENTOS_ANEL / 2 + 7);   // Lotes fora de fase com o anel e o setor
+        eventos_drenar();
+        eventos_estatisticas(&st);
+    }
+    CONFERIR_IGUAL(st.setores, alvo);
+    CONFERIR_IGUAL(st.seq, alvo);
+    CONFERIR_IGUAL(st.descartados, 2);
+    CONFERIR_IGUAL(mock_trafego()->flash_apagados, alvo);
+    for (uint32_t i = 0; i < EVENTOS_SETORES; ++i) {
+        const uint32_t seq = i < 3 ? EVENTOS_SETORES + 1 + i : i + 1;
+        if (!setor_confere(i, seq)) {
+            fprintf(stderr, "setor %u: esperado seq %u\n", (unsigned)i, (unsigned)seq);
+            CONFERIR(false);
+        }
+    }
+
+    // Nada fora da região: o setor logo abaixo continua apagado
+    const uint8_t *abaixo = (const uint8_t *)(XIP_BASE + EVENTOS_FLASH_INICIO - FLASH_SECTOR_SIZE);
+    bool apagado = true;
+    for (uint32_t k = 0; k < FLASH_SECTOR_SIZE; ++k) apagado &= abaixo[k] == 0xFF;
+    CONFERIR(apagado);
+
+    // Reboot: a varredura acha a sequência mais alta e grava no setor seguinte
+    eventos_init();
+    eventos_estatisticas(&st);
+    CONFERIR_IGUAL(st.seq, alvo);
+    CONFERIR_IGUAL(st.na_pagina, 0);   // O setor em RAM morre com o reboot
+
+    indice = alvo * EVENTOS_POR_SETOR;  // Próxima faixa, como se continuasse
+    while (st.seq == alvo) {
+        registrar(EVENTOS_POR_SETOR);
+        eventos_drenar();
+        eventos_estatisticas(&st);
+    }
+    CONFERIR_IGUAL(st.seq, alvo + 1);
+    CONFERIR(setor_confere(3, alvo + 1));
+    CONFERIR(setor_confere(2, alvo));
+    CONFERIR(setor_confere(4, 5));
+
+    return teste_fim("teste_eventos");
+}
@@ -0,0 +1,118 @@
+/* Envio do SSD1306 por janelas alteradas: bytes no I2C simulado (mock_hw.c)
+   por quadro e conteúdo da GDDRAM do modelo depois de cada envio.
+   Cada janela custa 7 bytes de comando (0x00 + 0x21 x0 x1 + 0x22 p0 p1)
+   mais 1 byte de prefixo 0x40 e os bytes da janela. No fim, um envio por DMA
+   recusado com NACK é cancelado e o seguinte vai completo. */
+#include "teste.h"
+#include "mock_hw.h"
+#include "ssd1306.h"
+
+#define LARGURA   128
+#define ALTURA    64
+#define JANELA    7    // Transação de comandos de uma janela
+
+typedef void (*desenho_t)(ssd1306_t *ssd);
+
+static ssd1306_t oled;
+
+/* Desenha o quadro inteiro, fecha e envia; retorna os bytes no barramento */
+static uint32_t enviar_quadro(desenho_t desenho) {
+    ssd1306_fill(&oled, false);
+    if (desenho) desenho(&oled);
+    ssd1306_swap(&oled);
+
+    const uint32_t antes = mock_trafego()->i2c_bytes;
+    ssd1306_send_data(&oled);
+    return mock_trafego()->i2c_bytes - antes;
+}
+
+/* A GDDRAM do modelo deve refletir o quadro da frente pixel a pixel */
+static bool gddram_confere(void) {
+    for (uint y = 0; y < ALTURA; ++y)
+        for (uint x = 0; x < LARGURA; ++x) {
+            const bool esperado = oled.front_buffer[(y / 8) * LARGURA + x + 1] & (1u << (y % 8));
+            if (mock_oled_pixel(x, y) != esperado) return false;
+        }
+    return true;
+}
+
+/* Envio por DMA do quadro desenhado; retorna se começou */
+static bool enviar_async(desenho_t desenho) {
+    ssd1306_fill(&oled, false);
+    if (desenho) desenho(&oled);
+    ssd1306_swap(&oled);
+    return ssd1306_send_data_async(&oled, NULL, NULL);
+}
+
+static void texto(ssd1306_t *ssd)  { ssd1306_draw_string(ssd, "Usuarios: 3", 0, 0, false); }
+static void ponto(ssd1306_t *ssd)  { texto(ssd); ssd1306_pixel(ssd, 10, 20, true); }
+static void barra(ssd1306_t *ssd)  { ponto(ssd); ssd1306_hline(ssd, 30, 49, 44, true); }
+
+int main(void) {
+    mock_hw_init();
+    ssd1306_init(&oled, LARGURA, ALTURA, false, 0x3C, i2c1);
+    ssd1306_config(&oled);
+
+    // Quadro completo: o primeiro envio não conhece a RAM do controlador
+    CONFERIR_IGUAL(enviar_quadro(texto), JANELA + 1 + LARGURA * ALTURA / 8);
+    CONFERIR_IGUAL(oled.bytes_sent, 1 + LARGURA * ALTURA / 8);
+    CONFERIR(gddram_confere());
+
+    // Quadro igual: tudo redesenhado e marcado, nada difere do último enviado
+    CONFERIR_IGUAL(enviar_quadro(texto), 0);
+
+    // Uma página alterada em uma coluna: janela de 1 byte na página 2
+    CONFERIR_IGUAL(enviar_quadro(ponto), JANELA + 1 + 1);
+    CONFERIR(mock_oled_pixel(10, 20));
+    CONFERIR(gddram_confere());
+
+    // Janela parcial de colunas: x 30..49 da página 5
+    CONFERIR_IGUAL(enviar_quadro(barra), JANELA + 1 + 20);
+    CONFERIR(mock_oled_pixel(30, 44) && mock_oled_pixel(49, 44));
+    CONFERIR(!mock_oled_pixel(29, 44) && !mock_oled_pixel(50, 44));
+    CONFERIR(gddram_confere());
+
+    // Apagar o que foi desenhado devolve as mesmas duas janelas
+    CONFERIR_IGUAL(enviar_quadro(texto), 2 * JANELA + (1 + 1) + (1 + 20));
+    CONFERIR(gddram_confere());
+
+    // Invalidar força de novo o quadro completo, mesmo sem mudança
+    ssd1306_invalidate(&oled);
+    CONFERIR_IGUAL(enviar_quadro(texto), JANELA + 1 + LARGURA * ALTURA / 8);
+
+    // NACK no envio por DMA: TX_ABRT sobe e o canal nunca termina
+    ssd1306_dma_init(&oled);
+    mock_i2c_nack(true);
+    CONFERIR(enviar_async(ponto));
+    sleep_ms(30);
+    mock_hw_processar();
+    CONFERIR(oled.dma_busy);
+
+    // O envio seguinte cancela o travado, limpa o abort e manda o quadro inteiro
+    mock_i2c_nack(false);
+    const uint32_t antes = mock_trafego()->i2c_bytes;
+    CONFERIR(enviar_async(ponto));
+    CONFERIR_IGUAL(oled.flush_aborted, 1);
+    CONFERIR_IGUAL(mock_trafego()->i2c_bytes - antes, JANELA + 1 + LARGURA * ALTURA / 8);
+    CONFERIR(!(i2c_get_hw(i2c1)->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS));
+    sleep_ms(30);
+    mock_hw_processar();
+    CONFERIR(!oled.dma_busy);
+    CONFERIR_IGUAL(oled.flush_started, 2);
+    CONFERIR_IGUAL(oled.flush_completed, 2);
+    CONFERIR(gddram_confere());
+
+    // Sem TX_ABRT (barramento preso): o prazo cancela a espera dos comandos
+    mock_i2c_nack(true);
+    CONFERIR(enviar_async(texto));
+    i2c_get_hw(i2c1)->raw_intr_stat = 0;
+    const uint32_t t0 = time_us_32();
+    ssd1306_command(&oled, 0xAF);
+    const uint32_t espera = time_us_32() - t0;
+    CONFERIR(espera >= SSD1306_TIMEOUT_US / 2 && espera < 4 * SSD1306_TIMEOUT_US);
+    CONFERIR_IGUAL(oled.flush_aborted, 2);
+    CONFERIR(!oled.dma_busy);
+    mock_i2c_nack(false);
+
+    return teste_fim("teste_ssd1306");
+}
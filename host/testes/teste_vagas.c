@@ -0,0 +1,84 @@
+/* Contador de admissão sob disputa: várias threads entram, saem e zeram a
+   mesma vaga ao mesmo tempo. A ocupação nunca passa da capacidade e, no fim,
+   bate com entradas - saídas - o que os resets devolveram. */
+#include <pthread.h>
+#include <stdatomic.h>
+#include "teste.h"
+#include "vagas.h"
+
+#define THREADS      8
+#define OPERACOES    2000000u   // por thread
+#define CAPACIDADE   10
+
+typedef struct {
+    uint32_t semente;
+    uint64_t entradas, saidas, recusas, vazias, zerados;
+} trabalho_t;
+
+static vagas_t          vagas;
+static _Atomic bool     excedeu;
+static _Atomic uint32_t maximo_visto;
+
+static uint32_t aleatorio(uint32_t *s) {   // xorshift32
+    *s ^= *s << 13; *s ^= *s >> 17; *s ^= *s << 5;
+    return *s;
+}
+
+static void *trabalhar(void *arg) {
+    trabalho_t *t = arg;
+    for (uint32_t i = 0; i < OPERACOES; ++i) {
+        const uint32_t r = aleatorio(&t->semente) % 1000;
+        if (r < 520) {
+            if (vagas_try_enter(&vagas)) ++t->entradas; else ++t->recusas;
+        } else if (r < 999) {
+            if (vagas_exit(&vagas)) ++t->saidas; else ++t->vazias;
+        } else {
+            t->zerados += vagas_reset(&vagas);
+        }
+
+        const uint32_t agora = vagas_ocupacao(&vagas);
+        if (agora > CAPACIDADE) atomic_store(&excedeu, true);
+        uint32_t max = atomic_load_explicit(&maximo_visto, memory_order_relaxed);
+        while (agora > max && !atomic_compare_exchange_weak(&maximo_visto, &max, agora)) {}
+    }
+    return NULL;
+}
+
+int main(void) {
+    vagas_init(&vagas, CAPACIDADE);
+
+    pthread_t  threads[THREADS];
+    trabalho_t trabalhos[THREADS] = { 0 };
+    for (int i = 0; i < THREADS; ++i) {
+        trabalhos[i].semente = 0x9E3779B9u * (uint32_t)(i + 1);
+        pthread_create(&threads[i], NULL, trabalhar, &trabalhos[i]);
+    }
+
+    uint64_t entradas = 0, saidas = 0, recusas = 0, zerados = 0;
+    for (int i = 0; i < THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+        entradas += trabalhos[i].entradas;
+        saidas   += trabalhos[i].saidas;
+        recusas  += trabalhos[i].recusas;
+        zerados  += trabalhos[i].zerados;
+    }
+
+    printf("entradas=%llu saidas=%llu recusas=%llu zerados=%llu final=%u maximo=%u\n",
+           (unsigned long long)entradas, (unsigned long long)saidas, (unsigned long long)recusas,
+           (unsigned long long)zerados, (unsigned)vagas_ocupacao(&vagas), (unsigned)maximo_visto);
+
+    CONFERIR(!excedeu);
+    CONFERIR(maximo_visto <= CAPACIDADE);
+    CONFERIR_IGUAL(vagas_ocupacao(&vagas), entradas - saidas - zerados);
+    CONFERIR(recusas > 0);   // A carga precisa ter lotado a vaga para valer como teste
+
+    // Sem disputa: lota, recusa, esvazia e não fica negativo
+    vagas_init(&vagas, CAPACIDADE);
+    for (int i = 0; i < CAPACIDADE; ++i) CONFERIR(vagas_try_enter(&vagas));
+    CONFERIR(!vagas_try_enter(&vagas));
+    CONFERIR_IGUAL(vagas_reset(&vagas), CAPACIDADE);
+    CONFERIR(!vagas_exit(&vagas));
+    CONFERIR_IGUAL(vagas_ocupacao(&vagas), 0);
+
+    return teste_fim("teste_vagas");
+}
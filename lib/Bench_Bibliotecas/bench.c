@@ -0,0 +1,147 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "matriz_led.h"
+
+void bench_cabecalho(void) {
+#ifdef PAINEL_HOST
+    printf("%-30s %8s %12s %10s\n", "Caso", "Iter", "ns/op", "B/quadro");
+#else
+    // Ciclos não contados: o SysTick é o tick do FreeRTOS, então saem do timer de 1 us
+    printf("%-30s %8s %12s %12s %10s\n", "Caso", "Iter", "ns/op", "~ciclos/op", "B/quadro");
+    printf("(~ciclos/op = tempo do timer de 1 us x clk_sys: derivado, nao contado)\n");
+#endif
+}
+
+void bench_executar(const char *nome, bench_fn_t fn, void *ctx, uint32_t iteracoes,
+                    const uint32_t *bytes_enviados) {
+    const uint32_t bytes_antes = bytes_enviados ? *bytes_enviados : 0;
+    const uint64_t inicio = time_us_64();
+    for (uint32_t i = 0; i < iteracoes; ++i) fn(ctx, i);
+    const uint64_t total_us = time_us_64() - inicio;
+
+    const unsigned long ns_op = (unsigned long)(total_us * 1000u / iteracoes);
+    printf("%-30s %8lu %12lu", nome, (unsigned long)iteracoes, ns_op);
+#ifndef PAINEL_HOST
+    const uint64_t ciclos = total_us * (clock_get_hz(clk_sys) / 1000000u);   // Derivado, ±1 us por caso
+    printf(" %12lu", (unsigned long)(ciclos / iteracoes));
+#endif
+    if (bytes_enviados)
+        printf(" %10lu\n", (unsigned long)((*bytes_enviados - bytes_antes) / iteracoes));
+    else
+        printf(" %10s\n", "-");
+}
+
+/* ---------- Casos ---------- */
+static void caso_fill(void *ctx, uint32_t i) {
+    ssd1306_fill(ctx, i & 1u);
+}
+
+/* Caminho anterior às primitivas por página: um ssd1306_pixel por pixel,
+   como eram fill e rect, para comparar antes/depois na mesma execução */
+static void pixel_fill(ssd1306_t *ssd, bool value) {
+    for (uint8_t y = 0; y < ssd->height; ++y)
+        for (uint8_t x = 0; x < ssd->width; ++x)
+            ssd1306_pixel(ssd, x, y, value);
+}
+
+static void pixel_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height,
+                       bool value, bool fill) {
+    for (uint8_t x = left; x < left + width; ++x) {
+        ssd1306_pixel(ssd, x, top, value);
+        ssd1306_pixel(ssd, x, top + height - 1, value);
+    }
+    for (uint8_t y = top; y < top + height; ++y) {
+        ssd1306_pixel(ssd, left, y, value);
+        ssd1306_pixel(ssd, left + width - 1, y, value);
+    }
+    if (fill)
+        for (uint8_t x = left + 1; x < left + width - 1; ++x)
+            for (uint8_t y = top + 1; y < top + height - 1; ++y)
+                ssd1306_pixel(ssd, x, y, value);
+}
+
+static void caso_fill_pixel(void *ctx, uint32_t i) {
+    pixel_fill(ctx, i & 1u);
+}
+
+static void caso_rect_pixel(void *ctx, uint32_t i) {
+    pixel_rect(ctx, 4 + (i & 7u), 10, 12, 12, true, true);
+}
+
+static void caso_rect_borda_pixel(void *ctx, uint32_t i) {
+    (void)i;
+    pixel_rect(ctx, 3, 3, 100, 50, true, false);
+}
+
+static void caso_string_alinhada(void *ctx, uint32_t i) {
+    ssd1306_draw_string(ctx, "Usuarios: 10/10", 2, 16 * (i & 3u), false);
+}
+
+static void caso_string_desalinhada(void *ctx, uint32_t i) {
+    ssd1306_draw_string(ctx, "Usuarios: 10/10", 2, 3 + (i & 7u), false);
+}
+
+static void caso_rect(void *ctx, uint32_t i) {
+    ssd1306_rect(ctx, 4 + (i & 7u), 10, 12, 12, true, true);
+}
+
+static void caso_rect_borda(void *ctx, uint32_t i) {
+    (void)i;
+    ssd1306_rect(ctx, 3, 3, 100, 50, true, false);
+}
+
+static void caso_line(void *ctx, uint32_t i) {
+    ssd1306_line(ctx, 0, 0, 127, 63 - (i & 7u), true);
+}
+
+/* Quadro com envio bloqueante: a contagem muda a cada iteração, como numa
+   entrada, e só as colunas alteradas vão para o barramento */
+static void caso_quadro_contagem(void *ctx, uint32_t i) {
+    ssd1306_t *ssd = ctx;
+    char buf[20];
+    snprintf(buf, sizeof(buf), "Usuarios: %lu/10", (unsigned long)(i % 10u));
+    ssd1306_fill(ssd, false);
+    ssd1306_draw_string(ssd, buf, 2, 0, false);
+    ssd1306_draw_string(ssd, "Estado: NORMAL", 2, 16, false);
+    ssd1306_swap(ssd);
+    ssd1306_send_data(ssd);
+}
+
+static void caso_matriz_numero(void *ctx, uint32_t i) {
+    (void)ctx;
+    matriz_draw_number(i % 10u, COR_VERDE);
+}
+
+static void caso_matriz_padrao(void *ctx, uint32_t i) {
+    (void)ctx;
+    matriz_draw_pattern((i & 1u) ? PAD_OK : PAD_X, COR_VERMELHO);
+}
+
+void bench_primitivas(ssd1306_t *ssd) {
+    bench_executar("ssd1306_fill",              caso_fill,               ssd, 2000, NULL);
+    bench_executar("  antes: pixel a pixel",    caso_fill_pixel,         ssd, 2000, NULL);
+    bench_executar("draw_string (y%8==0)",      caso_string_alinhada,    ssd, 2000, NULL);
+    bench_executar("draw_string (desalinhada)", caso_string_desalinhada, ssd, 2000, NULL);
+    bench_executar("ssd1306_rect (cheio 12x12)",caso_rect,               ssd, 2000, NULL);
+    bench_executar("  antes: pixel a pixel",    caso_rect_pixel,         ssd, 2000, NULL);
+    bench_executar("ssd1306_rect (borda)",      caso_rect_borda,         ssd, 2000, NULL);
+    bench_executar("  antes: pixel a pixel",    caso_rect_borda_pixel,   ssd, 2000, NULL);
+    bench_executar("ssd1306_line (diagonal)",   caso_line,               ssd, 2000, NULL);
+    bench_executar("quadro + send_data",        caso_quadro_contagem,    ssd, 200,  &ssd->bytes_sent);
+    bench_executar("matriz_draw_number",        caso_matriz_numero,      NULL, 2000, NULL);
+    bench_executar("matriz_draw_pattern",       caso_matriz_padrao,      NULL, 2000, NULL);
+}
+
+void bench_encerrar(void) {
+    printf("bench: fim\n");
+#ifdef PAINEL_HOST
+    exit(0);
+#else
+    while (1) vTaskDelay(portMAX_DELAY);
+#endif
+}
@@ -0,0 +1,24 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+/* ---------- Benchmark das primitivas de desenho ----------
+ * Cada caso roda N iterações cronometradas pelo time_us_64(): no RP2040 o
+ * timer de 1 MHz (convertido em ciclos de clk_sys: derivado, não contado,
+ * pois o SysTick serve ao tick do FreeRTOS), no host o relógio
+ * monotônico do mock (build com PAINEL_HOST). "B/quadro" é o que o driver
+ * do SSD1306 mandou ao display (bytes_sent) por iteração. As linhas
+ * "antes" refazem fill e rect pixel a pixel, como eram antes das primitivas
+ * por página, para medir o ganho na mesma execução. */
+typedef void (*bench_fn_t)(void *ctx, uint32_t i);  // i = número da iteração
+
+/* ---------- API ---------- */
+void bench_cabecalho(void);
+void bench_executar(const char *nome, bench_fn_t fn, void *ctx, uint32_t iteracoes,
+                    const uint32_t *bytes_enviados);  // NULL = caso sem envio
+void bench_primitivas(ssd1306_t *ssd);  // fill, draw_string, rect, line, quadro com envio, matriz
+void bench_encerrar(void);              // Host: sai do processo; placa: bloqueia a task
+
+#endif /* BENCH_H */
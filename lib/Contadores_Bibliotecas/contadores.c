@@ -0,0 +1,184 @@
+#include "contadores.h"
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "layout_flash.h"
+
+#define CONTADORES_MAGICA     0x31544e43u   // "CNT1"
+#define CHAVE_VAZIA           0xFF          // Byte apagado: fim do log do setor
+
+typedef struct {
+    uint8_t  chave;
+    uint8_t  verif;       // Detecta registro cortado por queda de energia
+    uint16_t reservado;   // Fica 0xFFFF
+    uint32_t valor;
+} registro_t;
+
+typedef struct {
+    uint32_t magica;
+    uint32_t geracao;
+} cabecalho_t;            // Ocupa a posição 0 do setor
+
+#define REGISTROS_POR_SETOR   (FLASH_SECTOR_SIZE / sizeof(registro_t))   // 512, o 1º é o cabeçalho
+#define REGISTROS_POR_PAGINA  (FLASH_PAGE_SIZE / sizeof(registro_t))
+
+_Static_assert(sizeof(registro_t) == 8 && sizeof(cabecalho_t) == sizeof(registro_t), "registro de 8 B");
+_Static_assert(CONTADORES_CHAVES < REGISTROS_POR_PAGINA, "compactação cabe na primeira página");
+
+static uint32_t valores[CONTADORES_CHAVES];
+static uint32_t gravados[CONTADORES_CHAVES];  // Último valor na flash
+static uint32_t setor_ativo;
+static uint32_t geracao;
+static uint32_t prox;                         // Próxima posição livre no setor ativo
+static contadores_stats_t stats;
+
+// Página montada em RAM: 0xFF não altera a flash, então só os registros novos são gravados
+static uint8_t pagina[FLASH_PAGE_SIZE] __attribute__((aligned(4)));
+
+static uint8_t verificacao(uint8_t chave, uint32_t valor) {
+    return (uint8_t)~(chave + (valor & 0xFF) + ((valor >> 8) & 0xFF) + ((valor >> 16) & 0xFF) + (valor >> 24));
+}
+
+static inline const registro_t *setor_flash(uint32_t s) {
+    return (const registro_t *)(XIP_BASE + CONTADORES_FLASH_INICIO + s * FLASH_SECTOR_SIZE);
+}
+
+static inline uint32_t offset_setor(uint32_t s) {
+    return CONTADORES_FLASH_INICIO + s * FLASH_SECTOR_SIZE;
+}
+
+void contadores_init(void) {
+    const uint32_t t0 = time_us_32();
+    memset(valores, 0, sizeof(valores));
+    memset(&stats, 0, sizeof(stats));
+
+    // Setor mais novo: só os cabeçalhos são lidos
+    bool achou = false;
+    geracao = 0;
+    for (uint32_t s = 0; s < CONTADORES_SETORES; ++s) {
+        const cabecalho_t *c = (const cabecalho_t *)setor_flash(s);
+        if (c->magica != CONTADORES_MAGICA || c->geracao == UINT32_MAX) continue;
+        if (!achou || c->geracao > geracao) {
+            achou = true;
+            geracao = c->geracao;
+            setor_ativo = s;
+        }
+    }
+
+    if (!achou) {
+        // Região vazia: a primeira gravação compacta no setor 0
+        setor_ativo = CONTADORES_SETORES - 1;
+        prox = REGISTROS_POR_SETOR;
+    } else {
+        // Varredura limitada a um setor: no máximo 511 registros
+        const registro_t *r = setor_flash(setor_ativo);
+        for (prox = 1; prox < REGISTROS_POR_SETOR && r[prox].chave != CHAVE_VAZIA; ++prox) {
+            if (r[prox].chave < CONTADORES_CHAVES && r[prox].verif == verificacao(r[prox].chave, r[prox].valor)) {
+                valores[r[prox].chave] = r[prox].valor;
+                ++stats.registros_lidos;
+            }
+        }
+    }
+    memcpy(gravados, valores, sizeof(gravados));
+    stats.carga_us = time_us_32() - t0;
+}
+
+uint32_t contadores_ler(uint8_t chave) {
+    return chave < CONTADORES_CHAVES ? valores[chave] : 0;
+}
+
+void contadores_definir(uint8_t chave, uint32_t valor) {
+    if (chave < CONTADORES_CHAVES) valores[chave] = valor;
+}
+
+static void escrever_registro(uint32_t posicao, uint8_t chave, uint32_t valor) {
+    registro_t *r = (registro_t *)&pagina[(posicao % REGISTROS_POR_PAGINA) * sizeof(registro_t)];
+    r->chave = chave;
+    r->verif = verificacao(chave, valor);
+    r->valor = valor;
+}
+
+/* ---------- Operações na flash (com o outro núcleo e as IRQs parados) ---------- */
+typedef struct {
+    uint32_t offset;
+    bool     apagar;         // Apaga o setor antes (compactação)
+    bool     cabecalho;      // Depois dos registros, grava o cabeçalho da nova geração
+} operacao_t;
+
+static void executar(void *arg) {
+    const operacao_t *op = arg;
+    if (op->apagar) flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+    flash_range_program(op->offset, pagina, FLASH_PAGE_SIZE);
+    if (op->cabecalho) {
+        // Cabeçalho por último: um setor só vale depois de ter todos os registros
+        memset(pagina, 0xFF, sizeof(pagina));
+        cabecalho_t *c = (cabecalho_t *)pagina;
+        c->magica = CONTADORES_MAGICA;
+        c->geracao = geracao + 1;
+        flash_range_program(op->offset, pagina, FLASH_PAGE_SIZE);
+    }
+}
+
+static bool programar(const operacao_t *op) {
+    if (flash_safe_execute(executar, (void *)op, UINT32_MAX) != PICO_OK) return false;
+    ++stats.paginas;
+    return true;
+}
+
+// Setor cheio: copia os valores atuais para o próximo setor do anel
+static uint32_t compactar(void) {
+    const uint32_t destino = (setor_ativo + 1) % CONTADORES_SETORES;
+    uint32_t n = 0;
+
+    memset(pagina, 0xFF, sizeof(pagina));
+    for (uint8_t k = 0; k < CONTADORES_CHAVES; ++k)
+        if (valores[k] != 0) escrever_registro(1 + n++, k, valores[k]);
+
+    const operacao_t op = { offset_setor(destino), true, true };
+    if (!programar(&op)) return 0;
+
+    ++stats.compactacoes;
+    ++geracao;
+    setor_ativo = destino;
+    prox = 1 + n;
+    memcpy(gravados, valores, sizeof(gravados));
+    return n;
+}
+
+uint32_t contadores_persistir(void) {
+    uint32_t alterados = 0;
+    for (uint8_t k = 0; k < CONTADORES_CHAVES; ++k) alterados += valores[k] != gravados[k];
+    if (alterados == 0) return 0;
+    if (prox + alterados > REGISTROS_POR_SETOR) return compactar();
+
+    // Acrescenta os registros, uma programação por página tocada
+    uint32_t escritos = 0;
+    uint8_t  k = 0;
+    while (k < CONTADORES_CHAVES) {
+        const uint32_t pag = prox / REGISTROS_POR_PAGINA;
+        const uint32_t inicio = prox;
+        uint32_t pendentes[CONTADORES_CHAVES], n = 0;
+
+        memset(pagina, 0xFF, sizeof(pagina));
+        for (; k < CONTADORES_CHAVES && prox / REGISTROS_POR_PAGINA == pag; ++k) {
+            if (valores[k] == gravados[k]) continue;
+            escrever_registro(prox++, k, valores[k]);
+            pendentes[n++] = k;
+        }
+        if (n == 0) break;
+
+        const operacao_t op = { offset_setor(setor_ativo) + pag * FLASH_PAGE_SIZE, false, false };
+        if (!programar(&op)) { prox = inicio; break; }   // Tenta de novo no próximo persistir
+        for (uint32_t i = 0; i < n; ++i) gravados[pendentes[i]] = valores[pendentes[i]];
+        escritos += n;
+    }
+    return escritos;
+}
+
+void contadores_estatisticas(contadores_stats_t *st) {
+    *st = stats;
+    st->setor = setor_ativo;
+    st->geracao = geracao;
+    st->livres = REGISTROS_POR_SETOR - prox;
+}
@@ -0,0 +1,35 @@
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ---------- Contadores persistentes com nivelamento de desgaste ----------
+ * Armazenamento só de acréscimo nos últimos setores da flash
+ * (layout_flash.h): cada mudança vira um registro de 8 B (chave,
+ * verificação, valor) programado sobre a área apagada da página, sem apagar nada. No boot, o setor de geração mais
+ * alta é lido até o primeiro registro vazio; o último valor de cada chave
+ * vence. Só quando o setor enche os valores atuais são compactados no
+ * setor seguinte do anel, o único momento com apagamento. Nenhuma função é
+ * reentrante: init antes do escalonador e o resto numa única task. */
+
+#define CONTADORES_CHAVES   16    // Chaves 0..15; nunca gravada = 0
+
+typedef struct {
+    uint32_t carga_us;         // Duração da varredura de boot
+    uint32_t registros_lidos;  // Registros válidos lidos no boot (≤ 511)
+    uint32_t setor;            // Setor ativo no anel
+    uint32_t geracao;          // Geração do setor ativo (0 = região vazia)
+    uint32_t livres;           // Posições de registro livres no setor ativo
+    uint32_t paginas;          // Páginas programadas desde o boot
+    uint32_t compactacoes;     // Setores apagados desde o boot
+} contadores_stats_t;
+
+/* ---------- API ---------- */
+void     contadores_init(void);                              // Varre a região e carrega os últimos valores
+uint32_t contadores_ler(uint8_t chave);
+void     contadores_definir(uint8_t chave, uint32_t valor);  // Só na RAM; vai à flash no próximo persistir
+uint32_t contadores_persistir(void);                         // Grava as chaves alteradas; retorna registros gravados
+void     contadores_estatisticas(contadores_stats_t *st);
+
+#endif /* CONTADORES_H */
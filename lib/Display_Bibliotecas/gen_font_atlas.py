@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""Gera generated/font_atlas.h a partir de font.h.
+
+Cada glifo 8x8 é gravado já no formato de página do SSD1306 (um byte por
+coluna, bit 0 = linha de cima), com os símbolos "girados" de font.h já
+transpostos, e uma tabela caractere -> glifo para busca O(1).
+
+Uso: python3 gen_font_atlas.py  (a partir de lib/Display_Bibliotecas)
+"""
+import os
+import re
+
+AQUI = os.path.dirname(os.path.abspath(__file__))
+
+# Índice do glifo em font.h (blocos de 8 bytes) e se está girado
+MAPA = {}
+for i in range(10):
+    MAPA[ord('0') + i] = (i + 1, False)
+for i in range(26):
+    MAPA[ord('A') + i] = (i + 11, False)
+    MAPA[ord('a') + i] = (i + 37, False)
+for c, idx in ((':', 64), ('.', 65), ('>', 66), ('-', 67),
+               ('!', 69), ('%', 70), ('/', 71)):
+    MAPA[ord(c)] = (idx, True)
+MAPA[127] = (68, False)  # Símbolo Ohm
+
+NUM_GLIFOS = 72
+
+
+def ler_fonte():
+    texto = open(os.path.join(AQUI, 'font.h'), encoding='utf-8').read()
+    texto = re.sub(r'//[^\n]*', '', texto)
+    corpo = texto[texto.index('{') + 1:texto.rindex('}')]
+    return [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]+', corpo)]
+
+
+def colunas(fonte, idx, girado):
+    linhas = fonte[idx * 8:idx * 8 + 8]
+    if not girado:
+        return linhas
+    # Girado: o bit j da linha i acende o pixel (7 - j, i)
+    cols = []
+    for c in range(8):
+        j = 7 - c
+        cols.append(sum(((linhas[i] >> j) & 1) << i for i in range(8)))
+    return cols
+
+
+def main():
+    fonte = ler_fonte()
+    girados = {idx for idx, g in MAPA.values() if g}
+    nomes = {idx: ('Ohm' if c == 127 else chr(c)) for c, (idx, _) in MAPA.items()}
+    out = []
+    out.append('// ------------------------------------------------------------ //')
+    out.append('// Gerado por gen_font_atlas.py a partir de font.h; não editar! //')
+    out.append('// ------------------------------------------------------------ //')
+    out.append('')
+    out.append('#pragma once')
+    out.append('')
+    out.append('#include <stdint.h>')
+    out.append('')
+    out.append('#define FONT_ATLAS_GLIFOS %d' % NUM_GLIFOS)
+    out.append('')
+    out.append('// Glifos 8x8 em colunas (bit 0 = linha de cima)')
+    out.append('static const uint8_t font_atlas[FONT_ATLAS_GLIFOS][8] = {')
+    for idx in range(NUM_GLIFOS):
+        cols = colunas(fonte, idx, idx in girados)
+        out.append('    {' + ', '.join('0x%02x' % b for b in cols) + '},  // %s' % nomes.get(idx, 'nada'))
+    out.append('};')
+    out.append('')
+    out.append('// Caractere ASCII -> glifo do atlas (0 = não suportado)')
+    out.append('static const uint8_t font_lookup[128] = {')
+    for c in sorted(MAPA):
+        out.append("    [%d] = %d,  // %s" % (c, MAPA[c][0], nomes[MAPA[c][0]]))
+    out.append('};')
+    out.append('')
+    destino = os.path.join(AQUI, 'generated', 'font_atlas.h')
+    with open(destino, 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
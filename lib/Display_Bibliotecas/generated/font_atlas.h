@@ -0,0 +1,159 @@
+// ------------------------------------------------------------ //
+// Gerado por gen_font_atlas.py a partir de font.h; não editar! //
+// ------------------------------------------------------------ //
+
+#pragma once
+
+#include <stdint.h>
+
+#define FONT_ATLAS_GLIFOS 72
+
+// Glifos 8x8 em colunas (bit 0 = linha de cima)
+static const uint8_t font_atlas[FONT_ATLAS_GLIFOS][8] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // nada
+    {0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00},  // 0
+    {0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00},  // 1
+    {0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00},  // 2
+    {0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00},  // 3
+    {0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00},  // 4
+    {0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00},  // 5
+    {0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00},  // 6
+    {0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00},  // 7
+    {0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00},  // 8
+    {0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00},  // 9
+    {0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00},  // A
+    {0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00},  // B
+    {0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00},  // C
+    {0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00},  // D
+    {0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00},  // E
+    {0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00},  // F
+    {0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00},  // G
+    {0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00},  // H
+    {0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00},  // I
+    {0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00},  // J
+    {0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00},  // K
+    {0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00},  // L
+    {0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00},  // M
+    {0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00},  // N
+    {0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00},  // O
+    {0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00},  // P
+    {0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00},  // Q
+    {0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00},  // R
+    {0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00},  // S
+    {0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00},  // T
+    {0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00},  // U
+    {0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00},  // V
+    {0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00},  // W
+    {0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00},  // X
+    {0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00},  // Y
+    {0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00},  // Z
+    {0x00, 0x20, 0x54, 0x54, 0x54, 0x34, 0x78, 0x00},  // a
+    {0x00, 0x7e, 0x50, 0x48, 0x48, 0x48, 0x30, 0x00},  // b
+    {0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x28, 0x00},  // c
+    {0x00, 0x30, 0x48, 0x48, 0x48, 0x50, 0x7e, 0x00},  // d
+    {0x00, 0x38, 0x54, 0x54, 0x54, 0x54, 0x18, 0x00},  // e
+    {0x00, 0x00, 0x08, 0x7c, 0x0a, 0x0a, 0x00, 0x00},  // f
+    {0x00, 0x48, 0x94, 0x94, 0x94, 0xb4, 0x78, 0x00},  // g
+    {0x00, 0x7e, 0x10, 0x08, 0x08, 0x08, 0x70, 0x00},  // h
+    {0x00, 0x00, 0x00, 0x74, 0x00, 0x00, 0x00, 0x00},  // i
+    {0x00, 0x60, 0x40, 0x74, 0x00, 0x00, 0x00, 0x00},  // j
+    {0x00, 0x7e, 0x08, 0x1c, 0x32, 0x42, 0x00, 0x00},  // k
+    {0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00},  // l
+    {0x00, 0x00, 0x78, 0x04, 0x78, 0x04, 0x78, 0x00},  // m
+    {0x00, 0x00, 0x00, 0x04, 0x78, 0x04, 0x78, 0x00},  // n
+    {0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00},  // o
+    {0x00, 0xfc, 0x24, 0x24, 0x24, 0x18, 0x00, 0x00},  // p
+    {0x00, 0x18, 0x24, 0x24, 0x24, 0xfc, 0x00, 0x00},  // q
+    {0x00, 0x78, 0x10, 0x08, 0x08, 0x08, 0x00, 0x00},  // r
+    {0x00, 0x48, 0x54, 0x54, 0x24, 0x00, 0x00, 0x00},  // s
+    {0x00, 0x00, 0x04, 0x7e, 0x44, 0x00, 0x00, 0x00},  // t
+    {0x00, 0x3c, 0x40, 0x40, 0x40, 0x20, 0x7c, 0x00},  // u
+    {0x00, 0x1c, 0x20, 0x40, 0x40, 0x20, 0x1c, 0x00},  // v
+    {0x00, 0x7c, 0x40, 0x30, 0x30, 0x40, 0x7c, 0x00},  // w
+    {0x00, 0x44, 0x28, 0x10, 0x10, 0x28, 0x44, 0x00},  // x
+    {0x00, 0x0c, 0x10, 0x60, 0x60, 0x10, 0x0c, 0x00},  // y
+    {0x00, 0x44, 0x64, 0x54, 0x4c, 0x44, 0x00, 0x00},  // z
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // nada
+    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00},  // :
+    {0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00},  // .
+    {0x00, 0x00, 0x44, 0x28, 0x10, 0x44, 0x28, 0x10},  // >
+    {0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08},  // -
+    {0x1c, 0x3e, 0x62, 0x02, 0x02, 0x62, 0x3e, 0x1c},  // Ohm
+    {0x00, 0x00, 0x00, 0x5e, 0x5e, 0x00, 0x00, 0x00},  // !
+    {0xe6, 0x10, 0xce, 0x00, 0x00, 0x00, 0x00, 0x00},  // %
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40},  // /
+};
+
+// Caractere ASCII -> glifo do atlas (0 = não suportado)
+static const uint8_t font_lookup[128] = {
+    [33] = 69,  // !
+    [37] = 70,  // %
+    [45] = 67,  // -
+    [46] = 65,  // .
+    [47] = 71,  // /
+    [48] = 1,  // 0
+    [49] = 2,  // 1
+    [50] = 3,  // 2
+    [51] = 4,  // 3
+    [52] = 5,  // 4
+    [53] = 6,  // 5
+    [54] = 7,  // 6
+    [55] = 8,  // 7
+    [56] = 9,  // 8
+    [57] = 10,  // 9
+    [58] = 64,  // :
+    [62] = 66,  // >
+    [65] = 11,  // A
+    [66] = 12,  // B
+    [67] = 13,  // C
+    [68] = 14,  // D
+    [69] = 15,  // E
+    [70] = 16,  // F
+    [71] = 17,  // G
+    [72] = 18,  // H
+    [73] = 19,  // I
+    [74] = 20,  // J
+    [75] = 21,  // K
+    [76] = 22,  // L
+    [77] = 23,  // M
+    [78] = 24,  // N
+    [79] = 25,  // O
+    [80] = 26,  // P
+    [81] = 27,  // Q
+    [82] = 28,  // R
+    [83] = 29,  // S
+    [84] = 30,  // T
+    [85] = 31,  // U
+    [86] = 32,  // V
+    [87] = 33,  // W
+    [88] = 34,  // X
+    [89] = 35,  // Y
+    [90] = 36,  // Z
+    [97] = 37,  // a
+    [98] = 38,  // b
+    [99] = 39,  // c
+    [100] = 40,  // d
+    [101] = 41,  // e
+    [102] = 42,  // f
+    [103] = 43,  // g
+    [104] = 44,  // h
+    [105] = 45,  // i
+    [106] = 46,  // j
+    [107] = 47,  // k
+    [108] = 48,  // l
+    [109] = 49,  // m
+    [110] = 50,  // n
+    [111] = 51,  // o
+    [112] = 52,  // p
+    [113] = 53,  // q
+    [114] = 54,  // r
+    [115] = 55,  // s
+    [116] = 56,  // t
+    [117] = 57,  // u
+    [118] = 58,  // v
+    [119] = 59,  // w
+    [120] = 60,  // x
+    [121] = 61,  // y
+    [122] = 62,  // z
+    [127] = 68,  // Ohm
+};
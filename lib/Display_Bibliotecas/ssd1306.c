@@ -1,11 +1,25 @@
 #include "ssd1306.h"
 #include "font.h"
+#include "generated/font_atlas.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+
+// Destino de cada janela alterada: escrita bloqueante ou buffer do DMA
+typedef void (*ssd1306_emit_t)(ssd1306_t *ssd, uint8_t p0, uint8_t p1, uint8_t x0, uint8_t x1);
+
+static bool ssd1306_wait_idle(ssd1306_t *ssd);
 
 // Inicializa a estrutura do display SSD1306
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+    if (width > SSD1306_MAX_WIDTH || height / 8 > SSD1306_MAX_PAGES) {
+        // Maior que os buffers estáticos: ajuste SSD1306_MAX_WIDTH/SSD1306_MAX_PAGES
+        while (1);
+    }
     ssd->width = width;
     ssd->height = height;
     ssd->pages = height / 8;
@@ -13,62 +27,282 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
     ssd->i2c_port = i2c;
     ssd->bufsize = ssd->pages * ssd->width + 1;
     
-    // Aloca buffer de dados
-    ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-    if (ssd->ram_buffer == NULL) {
-        // Em caso de falha, poderia adicionar tratamento de erro (ex.: log ou loop infinito)
-        while (1);
-    }
+    // Buffers de desenho e de envio e a cópia do último quadro enviado, dentro da própria estrutura
+    memset(ssd->buffers, 0, sizeof(ssd->buffers));
+    ssd->ram_buffer = ssd->buffers[0];
+    ssd->front_buffer = ssd->buffers[1];
+    ssd->shadow_buffer = ssd->buffers[2];
     
     // Inicializa buffers
     ssd->ram_buffer[0] = 0x40; // Prefixo de dados
+    ssd->front_buffer[0] = 0x40;
     ssd->port_buffer[0] = 0x00; // Prefixo de comando (Co=0, D/C=0)
+
+    // DMA é opcional: só é usado após ssd1306_dma_init()
+    ssd->dma_chan = -1;
+    ssd->dma_busy = false;
+    ssd->flush_started = 0;
+    ssd->flush_completed = 0;
+    ssd->flush_aborted = 0;
+    ssd->flush_cb = NULL;
+    ssd->flush_ctx = NULL;
+
+    // O conteúdo da RAM do controlador é desconhecido: o primeiro envio é completo
+    ssd->bytes_sent = 0;
+    ssd1306_invalidate(ssd);
+}
+
+// Marca colunas [x0, x1] da página como alteradas
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1) {
+    uint8_t bit = 1u << page;
+    if (!(ssd->dirty_pages & bit)) {
+        ssd->dirty_pages |= bit;
+        ssd->dirty_x0[page] = x0;
+        ssd->dirty_x1[page] = x1;
+        return;
+    }
+    if (x0 < ssd->dirty_x0[page]) ssd->dirty_x0[page] = x0;
+    if (x1 > ssd->dirty_x1[page]) ssd->dirty_x1[page] = x1;
 }
 
-// Configura os parâmetros iniciais do display
+// Força o próximo envio a transmitir o quadro inteiro
+void ssd1306_invalidate(ssd1306_t *ssd) {
+    for (uint8_t p = 0; p < ssd->pages; ++p) {
+        ssd1306_mark_dirty(ssd, p, 0, ssd->width - 1);
+    }
+    ssd->full_refresh = true;
+}
+
+// Configura os parâmetros iniciais do display (uma única transação I2C)
 void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, 0xAE); // Desliga o display
-    ssd1306_command(ssd, 0x20); // Define modo de memória
-    ssd1306_command(ssd, 0x00); // Endereçamento horizontal
-    ssd1306_command(ssd, 0x40); // Linha inicial
-    ssd1306_command(ssd, 0xA1); // Remapeia segmentos
-    ssd1306_command(ssd, 0xA8); // Define razão de multiplexação
-    ssd1306_command(ssd, ssd->height - 1);
-    ssd1306_command(ssd, 0xC8); // Define direção de varredura COM
-    ssd1306_command(ssd, 0xD3); // Define deslocamento do display
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, 0xDA); // Configura pinos COM
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, 0xD5); // Define divisor de clock
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, 0xD9); // Define período de pré-carga
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, 0xDB); // Define nível VCOMH
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, 0x81); // Define contraste
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, 0xA4); // Exibe conteúdo do buffer
-    ssd1306_command(ssd, 0xA6); // Modo normal (não invertido)
-    ssd1306_command(ssd, 0x8D); // Habilita charge pump
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, 0xAF); // Liga o display
+    const uint8_t init[] = {
+        0xAE,                   // Desliga o display
+        0x20, 0x00,             // Modo de memória: endereçamento horizontal
+        0x40,                   // Linha inicial
+        0xA1,                   // Remapeia segmentos
+        0xA8, ssd->height - 1,  // Define razão de multiplexação
+        0xC8,                   // Define direção de varredura COM
+        0xD3, 0x00,             // Define deslocamento do display
+        0xDA, 0x12,             // Configura pinos COM
+        0xD5, 0x80,             // Define divisor de clock
+        0xD9, 0xF1,             // Define período de pré-carga
+        0xDB, 0x30,             // Define nível VCOMH
+        0x81, 0xFF,             // Define contraste
+        0xA4,                   // Exibe conteúdo do buffer
+        0xA6,                   // Modo normal (não invertido)
+        0x8D, 0x14,             // Habilita charge pump
+        0xAF                    // Liga o display
+    };
+    ssd1306_command_list(ssd, init, sizeof(init));
 }
 
 // Envia um comando para o display via I2C
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+    ssd1306_wait_idle(ssd);
     ssd->port_buffer[1] = command;
     i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
 }
 
-// Envia o buffer de dados para o display
+// Envia uma sequência de comandos em uma única transação (prefixo 0x00, Co=0),
+// pagando START/endereço/STOP uma vez em vez de uma vez por byte
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, uint8_t count) {
+    uint8_t buf[SSD1306_MAX_CMDS + 1];
+    ssd1306_wait_idle(ssd);
+
+    buf[0] = 0x00;
+    while (count > 0) {
+        uint8_t n = (count > SSD1306_MAX_CMDS) ? SSD1306_MAX_CMDS : count;
+        memcpy(&buf[1], commands, n);
+        i2c_write_blocking(ssd->i2c_port, ssd->address, buf, n + 1, false);
+        commands += n;
+        count -= n;
+    }
+}
+
+// Envia as colunas [x0, x1] das páginas [p0, p1] com escritas bloqueantes
+static void ssd1306_send_window(ssd1306_t *ssd, uint8_t p0, uint8_t p1, uint8_t x0, uint8_t x1) {
+    const uint8_t window[] = {
+        0x21, x0, x1,           // Define endereço de coluna
+        0x22, p0, p1            // Define endereço de página
+    };
+    ssd1306_command_list(ssd, window, sizeof(window));
+
+    // O byte anterior à janela é emprestado para o prefixo de dados 0x40,
+    // evitando copiar a janela para um buffer temporário
+    uint16_t start = p0 * ssd->width + x0 + 1;
+    uint16_t len = (p1 == p0) ? (x1 - x0 + 1) : (p1 - p0 + 1) * ssd->width;
+    uint8_t saved = ssd->front_buffer[start - 1];
+    ssd->front_buffer[start - 1] = 0x40;
+    i2c_write_blocking(ssd->i2c_port, ssd->address, &ssd->front_buffer[start - 1], len + 1, false);
+    ssd->front_buffer[start - 1] = saved;
+}
+
+// Enfileira a mesma janela como palavras DATA_CMD para o DMA
+static void ssd1306_queue_window(ssd1306_t *ssd, uint8_t p0, uint8_t p1, uint8_t x0, uint8_t x1) {
+    uint16_t *w = &ssd->dma_buffer[ssd->dma_len];
+
+    // Transação de comandos: prefixo 0x00 + 6 bytes, STOP no último
+    *w++ = 0x00;
+    *w++ = 0x21; *w++ = x0; *w++ = x1;
+    *w++ = 0x22; *w++ = p0; *w++ = p1 | I2C_IC_DATA_CMD_STOP_BITS;
+
+    // Transação de dados: prefixo 0x40 + janela, STOP no último
+    uint16_t start = p0 * ssd->width + x0 + 1;
+    uint16_t len = (p1 == p0) ? (x1 - x0 + 1) : (p1 - p0 + 1) * ssd->width;
+    *w++ = 0x40;
+    for (uint16_t i = 0; i < len; ++i) *w++ = ssd->front_buffer[start + i];
+    w[-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    ssd->dma_len = w - ssd->dma_buffer;
+}
+
+// Percorre as janelas alteradas desde o último envio, entregando cada uma a 'emit'
+static void ssd1306_flush_windows(ssd1306_t *ssd, ssd1306_emit_t emit) {
+    if (ssd->full_refresh) {
+        emit(ssd, 0, ssd->pages - 1, 0, ssd->width - 1);
+        memcpy(ssd->shadow_buffer, ssd->front_buffer, ssd->bufsize);
+        ssd->bytes_sent += ssd->bufsize;
+        ssd->full_refresh = false;
+        ssd->dirty_pages = 0;
+        return;
+    }
+
+    for (uint8_t p = 0; p < ssd->pages; ++p) {
+        if (!(ssd->dirty_pages & (1u << p))) continue;
+
+        // Estreita a janela comparando com o último quadro enviado
+        uint8_t *novo = &ssd->front_buffer[p * ssd->width + 1];
+        uint8_t *antigo = &ssd->shadow_buffer[p * ssd->width + 1];
+        uint8_t x0 = ssd->dirty_x0[p], x1 = ssd->dirty_x1[p];
+        while (x0 <= x1 && novo[x0] == antigo[x0]) ++x0;
+        if (x0 > x1) continue;              // Página reescrita com o mesmo conteúdo
+        while (novo[x1] == antigo[x1]) --x1;
+
+        emit(ssd, p, p, x0, x1);
+        memcpy(&antigo[x0], &novo[x0], x1 - x0 + 1);
+        ssd->bytes_sent += x1 - x0 + 2;
+    }
+    ssd->dirty_pages = 0;
+}
+
+// Envio travado: um NACK (display ausente, endereço errado) aborta a transmissão,
+// o controlador descarta o FIFO e o DREQ não volta, então o DMA nunca terminaria
+static bool ssd1306_stalled(ssd1306_t *ssd, uint32_t start_us) {
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    return (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) ||
+           time_us_32() - start_us > SSD1306_TIMEOUT_US;
+}
+
+// Cancela o envio em curso e limpa o abort; a GDDRAM fica incerta, então o
+// próximo envio é do quadro inteiro
+static void ssd1306_abort(ssd1306_t *ssd) {
+    // IRQ do canal desligada durante o abort: ele pode sinalizar o fim (errata RP2040-E13)
+    dma_channel_set_irq0_enabled(ssd->dma_chan, false);
+    if (ssd->dma_busy) {
+        dma_channel_abort(ssd->dma_chan);
+        dma_channel_acknowledge_irq0(ssd->dma_chan);
+        ssd->dma_busy = false;
+        ++ssd->flush_completed;
+    }
+    dma_channel_set_irq0_enabled(ssd->dma_chan, true);
+
+    (void)i2c_get_hw(ssd->i2c_port)->clr_tx_abrt;  // A leitura limpa TX_ABRT
+    ++ssd->flush_aborted;
+    ssd1306_invalidate(ssd);
+}
+
+// Aguarda o fim de um envio por DMA e o esvaziamento do FIFO do I2C, no máximo
+// SSD1306_TIMEOUT_US desde o início do envio. Retorna false se teve de cancelá-lo.
+static bool ssd1306_wait_idle(ssd1306_t *ssd) {
+    if (ssd->dma_chan < 0) return true;
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    const uint32_t start_us = ssd->dma_busy ? ssd->dma_start_us : time_us_32();
+    while (ssd->dma_busy || !(hw->status & I2C_IC_STATUS_TFE_BITS) ||
+           (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS)) {
+        if (ssd1306_stalled(ssd, start_us)) {
+            ssd1306_abort(ssd);
+            return false;
+        }
+        tight_loop_contents();
+    }
+    return true;
+}
+
+// Troca os buffers: o quadro desenhado passa a ser o da frente (origem dos envios)
+// e o desenho seguinte recomeça sobre o quadro anterior. São só duas trocas de
+// ponteiro; quem desenha deve chamar com o mesmo lock usado para desenhar.
+// As marcas de alteração acumulam até o próximo envio, que as estreita pela
+// comparação com o último quadro enviado.
+void ssd1306_swap(ssd1306_t *ssd) {
+    uint8_t *pronto = ssd->ram_buffer;
+    ssd->ram_buffer = ssd->front_buffer;
+    ssd->front_buffer = pronto;
+}
+
+// Envia ao display apenas as janelas alteradas do quadro da frente
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, 0x21); // Define endereço de coluna
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, 0x22); // Define endereço de página
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
+    ssd1306_wait_idle(ssd);
+    ssd1306_flush_windows(ssd, ssd1306_send_window);
+}
+
+/* ---------- Envio assíncrono por DMA ---------- */
+
+static ssd1306_t *ssd_dma;   // Display atendido pela interrupção DMA_IRQ_0
+
+static void ssd1306_dma_irq(void) {
+    ssd1306_t *ssd = ssd_dma;
+    if (ssd == NULL || !dma_channel_get_irq0_status(ssd->dma_chan)) return;
+    dma_channel_acknowledge_irq0(ssd->dma_chan);
+
+    ssd->dma_busy = false;
+    ++ssd->flush_completed;
+    if (ssd->flush_cb) ssd->flush_cb(ssd->flush_ctx);
+}
+
+// Reserva um canal DMA; o buffer de palavras DATA_CMD já está na estrutura
+void ssd1306_dma_init(ssd1306_t *ssd) {
+    ssd->dma_chan = dma_claim_unused_channel(true);
+
+    dma_channel_config c = dma_channel_get_default_config(ssd->dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+    dma_channel_configure(ssd->dma_chan, &c, &i2c_get_hw(ssd->i2c_port)->data_cmd,
+                          ssd->dma_buffer, 0, false);
+
+    ssd_dma = ssd;
+    dma_channel_set_irq0_enabled(ssd->dma_chan, true);
+    irq_add_shared_handler(DMA_IRQ_0, ssd1306_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+// Inicia o envio das janelas alteradas do quadro da frente sem bloquear. O quadro
+// é copiado para o buffer do DMA, então a próxima troca já pode reutilizá-lo.
+// Retorna false se não há nada a enviar ou se o envio anterior ainda está em curso;
+// um envio anterior travado (NACK ou prazo) é cancelado e este vai completo.
+bool ssd1306_send_data_async(ssd1306_t *ssd, ssd1306_flush_cb_t cb, void *ctx) {
+    if (ssd->dma_busy && !ssd1306_stalled(ssd, ssd->dma_start_us)) return false;
+
+    // Aguarda o fim de escritas bloqueantes anteriores antes de trocar o endereço alvo
+    ssd1306_wait_idle(ssd);
+
+    ssd->dma_len = 0;
+    ssd1306_flush_windows(ssd, ssd1306_queue_window);
+    if (ssd->dma_len == 0) return false;
+
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    hw->enable = 0;
+    hw->tar = ssd->address;
+    hw->enable = 1;
+
+    ssd->flush_cb = cb;
+    ssd->flush_ctx = ctx;
+    ssd->dma_busy = true;
+    ssd->dma_start_us = time_us_32();
+    ++ssd->flush_started;
+    dma_channel_transfer_from_buffer_now(ssd->dma_chan, ssd->dma_buffer, ssd->dma_len);
+    return true;
 }
 
 // Desenha um pixel no buffer
@@ -76,6 +310,7 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
     if (x >= ssd->width || y >= ssd->height) return; // Verifica limites
     uint16_t index = (y / 8) * ssd->width + x + 1;
     uint8_t pixel = y % 8;
+    ssd1306_mark_dirty(ssd, y / 8, x, x);
     if (value) {
         ssd->ram_buffer[index] |= (1 << pixel);
     } else {
@@ -83,12 +318,32 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
     }
 }
 
+// Preenche as colunas [x0, x1] das linhas [y0, y1], já recortadas à tela.
+// Cada página recebe a máscara das suas linhas; páginas inteiras viram memset.
+static void ssd1306_span(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y0, uint8_t y1, bool value) {
+    uint8_t n = x1 - x0 + 1;
+    for (uint8_t p = y0 / 8; p <= y1 / 8; ++p) {
+        uint8_t top = (p == y0 / 8) ? y0 % 8 : 0;
+        uint8_t bot = (p == y1 / 8) ? y1 % 8 : 7;
+        uint8_t mask = (uint8_t)((0xFFu << top) & (0xFFu >> (7 - bot)));
+        uint8_t *col = &ssd->ram_buffer[p * ssd->width + x0 + 1];
+
+        if (mask == 0xFF) {
+            memset(col, value ? 0xFF : 0x00, n);
+        } else if (value) {
+            for (uint8_t i = 0; i < n; ++i) col[i] |= mask;
+        } else {
+            for (uint8_t i = 0; i < n; ++i) col[i] &= ~mask;
+        }
+        ssd1306_mark_dirty(ssd, p, x0, x1);
+    }
+}
+
 // Preenche a tela com pixels ligados ou desligados
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+    memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, ssd->bufsize - 1);
+    for (uint8_t p = 0; p < ssd->pages; ++p) {
+        ssd1306_mark_dirty(ssd, p, 0, ssd->width - 1);
     }
 }
 
@@ -109,6 +364,31 @@ index + i];
     }
 }
 
+// Copia 'n' colunas de 8 pixels (formato de página) para (x, y). Com y múltiplo
+// de 8 é uma cópia direta; caso contrário cada coluna se divide em duas páginas.
+static void ssd1306_blit_columns(ssd1306_t *ssd, uint8_t x, uint8_t y, const uint8_t *cols, uint8_t n) {
+    if (x >= ssd->width || y >= ssd->height) return;
+    if (n > ssd->width - x) n = ssd->width - x;
+
+    uint8_t page = y / 8, shift = y % 8;
+    uint8_t *dst = &ssd->ram_buffer[page * ssd->width + x + 1];
+
+    if (shift == 0) {
+        for (uint8_t i = 0; i < n; ++i) dst[i] = cols[i];
+        ssd1306_mark_dirty(ssd, page, x, x + n - 1);
+        return;
+    }
+
+    uint8_t mask = 0xFF << shift;
+    for (uint8_t i = 0; i < n; ++i) dst[i] = (dst[i] & ~mask) | (uint8_t)(cols[i] << shift);
+    ssd1306_mark_dirty(ssd, page, x, x + n - 1);
+
+    if (page + 1 >= ssd->pages) return;   // Metade de baixo fora da tela
+    dst += ssd->width;
+    for (uint8_t i = 0; i < n; ++i) dst[i] = (dst[i] & mask) | (cols[i] >> (8 - shift));
+    ssd1306_mark_dirty(ssd, page + 1, x, x + n - 1);
+}
+
 // Desenha um caractere
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_small_numbers) {
     if (use_small_numbers && c >= '0' && c <= '9') {
@@ -116,54 +396,11 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_sm
         return;
     }
 
-    uint16_t index = 0;
-    bool rotate = false;
-
-    // Mapeia caracteres
-    if (c >= '0' && c <= '9') {
-        index = (c - '0' + 1) * 8;
-    } else if (c >= 'A' && c <= 'Z') {
-        index = (c - 'A' + 11) * 8;
-    } else if (c >= 'a' && c <= 'z') {
-        index = (c - 'a' + 37) * 8;
-    } else if (c == ':') {
-        index = 64 * 8;
-        rotate = true;
-    } else if (c == '.') {
-        index = 65 * 8;
-        rotate = true;
-    } else if (c == '>') {
-        index = 66 * 8;
-        rotate = true;
-    } else if (c == '-') {
-        index = 67 * 8;
-        rotate = true;
-    } else if (c == 127) {
-        index = 68 * 8; // Símbolo Ohm
-    } else if (c == '!') {
-        index = 69 * 8;
-        rotate = true;
-    }
-    else if (c == '%') {
-        index = 70 * 8;
-        rotate = true;
-    } 
-    else if (c == '/') {
-        index = 71 * 8;
-        rotate = true;
-    } 
-    else {
-        return; // Caractere não suportado
-    }
-
-    // Renderiza caractere
-    for (uint8_t i = 0; i < 8; ++i) {
-        uint8_t line = font[index + i];
-        for (uint8_t j = 0; j < 8; ++j) {
-            bool pixel_value = rotate ? (line >> j) & 0x01 : (line >> j) & 0x01;
-            ssd1306_pixel(ssd, x + (rotate ? (7 - j) : i), y + (rotate ? i : j), pixel_value);
-        }
-    }
+    // Glifo já girado no atlas gerado (generated/font_atlas.h)
+    uint8_t glyph = ((uint8_t)c < 128) ? font_lookup[(uint8_t)c] : 0;
+    if (glyph == 0) return; // Caractere não suportado
+
+    ssd1306_blit_columns(ssd, x, y, font_atlas[glyph], 8);
 }
 
 // Desenha uma string
@@ -187,21 +424,23 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y,
 
 // Desenha um retângulo
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-    for (uint8_t x = left; x < left + width; ++x) {
-        ssd1306_pixel(ssd, x, top, value);
-        ssd1306_pixel(ssd, x, top + height - 1, value);
-    }
-    for (uint8_t y = top; y < top + height; ++y) {
-        ssd1306_pixel(ssd, left, y, value);
-        ssd1306_pixel(ssd, left + width - 1, y, value);
-    }
+    if (width == 0 || height == 0) return;
+    if (left >= ssd->width || top >= ssd->height) return;
+    uint16_t right = left + width - 1;
+    uint16_t bottom = top + height - 1;
+    uint8_t x1 = (right >= ssd->width) ? ssd->width - 1 : right;
+    uint8_t y1 = (bottom >= ssd->height) ? ssd->height - 1 : bottom;
+
     if (fill) {
-        for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-            for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-                ssd1306_pixel(ssd, x, y, value);
-            }
-        }
+        // Contorno e interior têm o mesmo valor: um único bloco por página
+        ssd1306_span(ssd, left, x1, top, y1, value);
+        return;
     }
+
+    ssd1306_hline(ssd, left, x1, top, value);
+    if (bottom < ssd->height) ssd1306_hline(ssd, left, x1, bottom, value);
+    ssd1306_vline(ssd, left, top, y1, value);
+    if (right < ssd->width) ssd1306_vline(ssd, right, top, y1, value);
 }
 
 // Desenha uma linha (Bresenham)
@@ -219,16 +458,16 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0,
     }
 }
 
-// Desenha uma linha horizontal
+// Desenha uma linha horizontal (um bit por coluna na mesma página)
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-    for (uint8_t x = x0; x <= x1; ++x) {
-        ssd1306_pixel(ssd, x, y, value);
-    }
+    if (x0 > x1 || x0 >= ssd->width || y >= ssd->height) return;
+    if (x1 >= ssd->width) x1 = ssd->width - 1;
+    ssd1306_span(ssd, x0, x1, y, y, value);
 }
 
-// Desenha uma linha vertical
+// Desenha uma linha vertical (uma máscara por página)
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-    for (uint8_t y = y0; y <= y1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-    }
-}
\ No newline at end of file
+    if (y0 > y1 || x >= ssd->width || y0 >= ssd->height) return;
+    if (y1 >= ssd->height) y1 = ssd->height - 1;
+    ssd1306_span(ssd, x, x, y0, y1, value);
+}
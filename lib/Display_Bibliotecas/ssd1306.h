@@ -6,19 +6,58 @@
 #include <stdbool.h>
 #include "hardware/i2c.h"
 
+#define SSD1306_MAX_PAGES 8   // 64 linhas / 8 linhas por página
+#define SSD1306_MAX_CMDS  32  // Comandos por transação em ssd1306_command_list
+#define SSD1306_TIMEOUT_US 50000  // Prazo de um envio; o quadro inteiro leva ~23 ms a 400 kHz
+
+// Buffers dimensionados em tempo de compilação para o maior display suportado
+// (ssd1306_init trava se width/height passarem disso)
+#ifndef SSD1306_MAX_WIDTH
+#define SSD1306_MAX_WIDTH 128
+#endif
+#define SSD1306_BUFSIZE     (SSD1306_MAX_PAGES * SSD1306_MAX_WIDTH + 1)      // Prefixo 0x40 + GDDRAM
+#define SSD1306_DMA_WORDS   (SSD1306_MAX_PAGES * (SSD1306_MAX_WIDTH + 8))    // Pior caso: uma janela por página
+
+typedef void (*ssd1306_flush_cb_t)(void *ctx);  // Chamada na IRQ ao fim do envio por DMA
+
 typedef struct {
     uint8_t width, height, pages, address;
     i2c_inst_t *i2c_port;
     uint16_t bufsize;
-    uint8_t *ram_buffer;
+    uint8_t *ram_buffer;                  // Buffer de desenho (back)
+    uint8_t *front_buffer;                // Último quadro fechado por ssd1306_swap (front)
+    uint8_t *shadow_buffer;               // Último quadro enviado ao display
+    uint8_t buffers[3][SSD1306_BUFSIZE];  // Armazenamento dos três acima (trocados por ponteiro)
     uint8_t port_buffer[2];
+    uint8_t dirty_pages;                  // Bit n = página n alterada desde o último envio
+    uint8_t dirty_x0[SSD1306_MAX_PAGES];  // Primeira coluna alterada em cada página
+    uint8_t dirty_x1[SSD1306_MAX_PAGES];  // Última coluna alterada em cada página
+    bool full_refresh;                    // Próximo envio transmite o quadro inteiro
+    uint32_t bytes_sent;                  // Total de bytes de dados enviados via I2C
+
+    /* Envio assíncrono por DMA (ssd1306_dma_init) */
+    int dma_chan;                         // -1 = DMA não inicializado
+    uint16_t dma_buffer[SSD1306_DMA_WORDS];  // Palavras DATA_CMD (byte + bit STOP)
+    uint16_t dma_len;
+    volatile bool dma_busy;
+    volatile uint32_t flush_started;      // Envios iniciados
+    volatile uint32_t flush_completed;    // Envios concluídos ou cancelados (em andamento = started - completed)
+    uint32_t flush_aborted;               // Envios cancelados por NACK (TX_ABRT) ou prazo
+    uint32_t dma_start_us;                // Início do envio em curso
+    ssd1306_flush_cb_t flush_cb;
+    void *flush_ctx;
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height,
                   bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, uint8_t count);
+void ssd1306_swap(ssd1306_t *ssd);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_invalidate(ssd1306_t *ssd);
+void ssd1306_dma_init(ssd1306_t *ssd);
+bool ssd1306_send_data_async(ssd1306_t *ssd, ssd1306_flush_cb_t cb, void *ctx);
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0,
@@ -0,0 +1,32 @@
+#include "energia.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+static uint64_t inicio_sono_us = 0;
+static uint64_t sono_total_us  = 0;
+static uint32_t num_sonos      = 0;
+
+void energia_pre_sono(void) {
+    inicio_sono_us = time_us_64();
+}
+
+void energia_pos_sono(void) {
+    sono_total_us += time_us_64() - inicio_sono_us;
+    ++num_sonos;
+}
+
+uint64_t energia_sono_us(void) {
+    uint32_t irq = save_and_disable_interrupts();  // 64 bits: evita leitura rasgada
+    uint64_t total = sono_total_us;
+    restore_interrupts(irq);
+    return total;
+}
+
+uint32_t energia_sonos(void) {
+    return num_sonos;
+}
+
+uint32_t energia_residencia_permil(void) {
+    uint64_t agora = time_us_64();
+    return agora ? (uint32_t)(energia_sono_us() * 1000u / agora) : 0;
+}
@@ -0,0 +1,20 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include <stdint.h>
+
+/* ---------- Residência em sono (tickless idle) ----------
+ * O kernel chama energia_pre_sono/energia_pos_sono (configPRE/POST_SLEEP_
+ * PROCESSING no FreeRTOSConfig.h) em volta do WFI, com as interrupções
+ * desabilitadas. Qualquer IRQ habilitada acorda o núcleo, inclusive as de
+ * GPIO dos botões e do joystick; o tempo medido é só o do WFI, lido do
+ * timer de 1 MHz do RP2040. */
+
+/* ---------- API ---------- */
+void     energia_pre_sono(void);           // Marca o início do sono
+void     energia_pos_sono(void);           // Acumula o trecho dormido
+uint64_t energia_sono_us(void);            // Tempo total dormindo desde o boot (µs)
+uint32_t energia_sonos(void);              // Quantas vezes o núcleo dormiu
+uint32_t energia_residencia_permil(void);  // Fração do tempo desde o boot em sono (‰)
+
+#endif /* ENERGIA_H */
@@ -0,0 +1,125 @@
+#include "eventos.h"
+#include <stdatomic.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "layout_flash.h"
+
+#define EVENTOS_MAGICA        0x31545645u   // "EVT1"
+
+// Imagem de um setor da região, na RAM e na flash
+typedef struct {
+    uint32_t magica;
+    uint32_t seq;
+    evento_t eventos[EVENTOS_POR_SETOR];
+} setor_eventos_t;
+
+_Static_assert(sizeof(setor_eventos_t) == FLASH_SECTOR_SIZE, "setor do log deve ocupar 4 KB");
+_Static_assert((EVENTOS_ANEL & (EVENTOS_ANEL - 1)) == 0, "EVENTOS_ANEL deve ser potência de 2");
+
+// Posição do anel: 'seq' = posição + 1 quando o registro está publicado
+typedef struct {
+    _Atomic uint32_t seq;
+    evento_t ev;
+} posicao_t;
+
+static posicao_t        anel[EVENTOS_ANEL];
+static _Atomic uint32_t cabeca;        // Próxima posição a reservar (produtores)
+static _Atomic uint32_t cauda;         // Próxima posição a drenar (só o escritor avança)
+static _Atomic uint32_t descartados;
+
+// Estado do escritor (só eventos_drenar mexe)
+static setor_eventos_t pagina;
+static uint32_t        na_pagina;
+static uint32_t        setor_prox;     // Índice do próximo setor da região a gravar
+static uint32_t        seq_atual;      // Sequência do último setor gravado
+static uint32_t        setores_gravados;
+static uint32_t        falhas;
+
+static inline const setor_eventos_t *setor_flash(uint32_t i) {
+    return (const setor_eventos_t *)(XIP_BASE + EVENTOS_FLASH_INICIO + i * FLASH_SECTOR_SIZE);
+}
+
+void eventos_init(void) {
+    bool achou = false;
+    for (uint32_t i = 0; i < EVENTOS_SETORES; ++i) {
+        const setor_eventos_t *s = setor_flash(i);
+        if (s->magica != EVENTOS_MAGICA || s->seq == UINT32_MAX) continue;  // Apagado ou de outro formato
+        if (!achou || s->seq > seq_atual) {
+            achou = true;
+            seq_atual = s->seq;
+            setor_prox = (i + 1) % EVENTOS_SETORES;  // Sobrescreve o mais antigo
+        }
+    }
+    if (!achou) { seq_atual = 0; setor_prox = 0; }
+    na_pagina = 0;
+}
+
+bool eventos_registrar(tipo_evento_log_t tipo, uint8_t zona, uint32_t valor) {
+    uint32_t pos = atomic_load_explicit(&cabeca, memory_order_relaxed);
+    do {
+        if (pos - atomic_load_explicit(&cauda, memory_order_acquire) >= EVENTOS_ANEL) {
+            atomic_fetch_add_explicit(&descartados, 1, memory_order_relaxed);
+            return false;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&cabeca, &pos, pos + 1,
+                                                    memory_order_relaxed, memory_order_relaxed));
+
+    posicao_t *p = &anel[pos & (EVENTOS_ANEL - 1)];
+    p->ev.ts_ms = xTaskGetTickCount();
+    p->ev.tipo  = (uint8_t)tipo;
+    p->ev.zona  = zona;
+    p->ev.valor = valor > UINT16_MAX ? UINT16_MAX : (uint16_t)valor;
+    atomic_store_explicit(&p->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+// Executada com o outro núcleo e as interrupções parados (flash_safe_execute)
+static void gravar_setor(void *arg) {
+    const uint32_t offset = *(const uint32_t *)arg;
+    flash_range_erase(offset, FLASH_SECTOR_SIZE);
+    flash_range_program(offset, (const uint8_t *)&pagina, FLASH_SECTOR_SIZE);
+}
+
+static bool gravar_pagina(void) {
+    pagina.magica = EVENTOS_MAGICA;
+    pagina.seq = seq_atual + 1;
+    uint32_t offset = EVENTOS_FLASH_INICIO + setor_prox * FLASH_SECTOR_SIZE;
+    if (flash_safe_execute(gravar_setor, &offset, UINT32_MAX) != PICO_OK) {
+        ++falhas;                                 // Página mantida: tenta de novo na próxima drenagem
+        return false;
+    }
+    seq_atual = pagina.seq;
+    setor_prox = (setor_prox + 1) % EVENTOS_SETORES;
+    ++setores_gravados;
+    na_pagina = 0;
+    return true;
+}
+
+uint32_t eventos_drenar(void) {
+    uint32_t pos = atomic_load_explicit(&cauda, memory_order_relaxed);
+    uint32_t movidos = 0;
+
+    while (1) {
+        if (na_pagina == EVENTOS_POR_SETOR && !gravar_pagina()) break;
+
+        posicao_t *p = &anel[pos & (EVENTOS_ANEL - 1)];
+        if (atomic_load_explicit(&p->seq, memory_order_acquire) != pos + 1) break;  // Vazio ou em escrita
+
+        pagina.eventos[na_pagina++] = p->ev;
+        atomic_store_explicit(&cauda, ++pos, memory_order_release);             // Libera a posição
+        ++movidos;
+    }
+    return movidos;
+}
+
+void eventos_estatisticas(eventos_stats_t *st) {
+    st->descartados = atomic_load_explicit(&descartados, memory_order_relaxed);
+    st->registrados = atomic_load_explicit(&cabeca, memory_order_relaxed);
+    st->setores = setores_gravados;
+    st->falhas = falhas;
+    st->seq = seq_atual;
+    st->na_pagina = na_pagina;
+}
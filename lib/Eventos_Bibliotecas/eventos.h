@@ -0,0 +1,51 @@
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ---------- Log de eventos em anel + flash ----------
+ * Produtores (tasks) reservam uma posição do anel com um CAS e publicam o
+ * registro com o número de sequência da posição: sem locks e sem chamadas
+ * ao kernel. Um único escritor de baixa prioridade (eventos_drenar) copia
+ * os registros para um setor de 4 KB em RAM e só grava na flash quando ele
+ * enche: um apagamento + programação por setor, nunca no caminho da entrada.
+ * A região na flash (layout_flash.h) é circular; cada setor começa com um
+ * cabeçalho com número de sequência, e eventos_init acha o mais novo lendo
+ * só os cabeçalhos. */
+
+#ifndef EVENTOS_ANEL
+#define EVENTOS_ANEL       1024   // Registros no anel (potência de 2)
+#endif
+#define EVENTOS_POR_SETOR  511    // (4096 - cabeçalho de 8 B) / 8 B
+
+typedef enum {
+    LOG_ENTRADA,   // valor = ocupação após a entrada
+    LOG_SAIDA,     // valor = ocupação após a saída
+    LOG_RECUSA,    // entrada com a zona lotada; valor = ocupação (a capacidade)
+    LOG_RESET      // valor = quantos estavam na zona zerada
+} tipo_evento_log_t;
+
+typedef struct {
+    uint32_t ts_ms;   // Tick do FreeRTOS (1 kHz) no registro
+    uint8_t  tipo;    // tipo_evento_log_t
+    uint8_t  zona;
+    uint16_t valor;   // Satura em 65535
+} evento_t;
+
+typedef struct {
+    uint32_t registrados;   // Aceitos no anel desde o boot
+    uint32_t descartados;   // Anel cheio: o escritor não acompanhou
+    uint32_t setores;       // Setores gravados desde o boot
+    uint32_t falhas;        // Gravações adiadas (flash_safe_execute recusou)
+    uint32_t seq;           // Sequência do último setor na flash (0 = nenhum)
+    uint32_t na_pagina;     // Registros no setor em RAM, ainda não gravados
+} eventos_stats_t;
+
+/* ---------- API ---------- */
+void     eventos_init(void);                                          // Acha o próximo setor livre da região
+bool     eventos_registrar(tipo_evento_log_t tipo, uint8_t zona, uint32_t valor);  // false = anel cheio
+uint32_t eventos_drenar(void);                                        // Só o escritor; retorna registros movidos
+void     eventos_estatisticas(eventos_stats_t *st);
+
+#endif /* EVENTOS_H */
@@ -0,0 +1,37 @@
+#ifndef LAYOUT_FLASH_H
+#define LAYOUT_FLASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/flash.h"
+
+/* ---------- Mapa das regiões de dados no fim da flash ----------
+ * Do fim para o começo: contadores persistentes (anel de setores com
+ * compactação) e, logo abaixo, o log de eventos. Os dois módulos só leem
+ * daqui o início e o tamanho da própria região; nenhum depende do outro.
+ * Com os valores padrão são 72 setores (288 KB), fora do binário só
+ * enquanto a imagem couber no resto: layout_flash_livre() confere no boot. */
+
+#ifndef CONTADORES_SETORES
+#define CONTADORES_SETORES  8     // Setores de 4 KB no fim da flash, usados em anel
+#endif
+#ifndef EVENTOS_SETORES
+#define EVENTOS_SETORES     64    // Setores de 4 KB (256 KB) logo abaixo dos contadores
+#endif
+
+#define CONTADORES_FLASH_INICIO  (PICO_FLASH_SIZE_BYTES - CONTADORES_SETORES * FLASH_SECTOR_SIZE)
+#define EVENTOS_FLASH_INICIO     (CONTADORES_FLASH_INICIO - EVENTOS_SETORES * FLASH_SECTOR_SIZE)
+#define DADOS_FLASH_INICIO       EVENTOS_FLASH_INICIO   // Nada do firmware pode passar daqui
+
+#ifndef PAINEL_HOST
+extern char __flash_binary_end;   // Fim da imagem na flash (linker script do SDK)
+
+static inline bool layout_flash_livre(void) {
+    return (uintptr_t)&__flash_binary_end <= XIP_BASE + DADOS_FLASH_INICIO;
+}
+#else
+// No host a imagem não ocupa a flash simulada
+static inline bool layout_flash_livre(void) { return true; }
+#endif
+
+#endif /* LAYOUT_FLASH_H */
@@ -40,9 +40,25 @@
   * See http://www.freertos.org/a00110.html
   *----------------------------------------------------------*/
  
+ /* Opções do painel (definidas pelo CMakeLists.txt) */
+ /* PAINEL_SMP=1 (cmake -DPAINEL_SMP=ON): entrada num núcleo, saída no outro */
+ #ifndef PAINEL_SMP
+ #define PAINEL_SMP                              0
+ #endif
+ /* PAINEL_BAIXO_CONSUMO=1: tickless idle, o núcleo dorme em WFI até a
+    próxima task ou IRQ em vez de acordar a cada tick (não suportado no SMP) */
+ #ifndef PAINEL_BAIXO_CONSUMO
+ #define PAINEL_BAIXO_CONSUMO                    1
+ #endif
+
  /* Scheduler Related */
  #define configUSE_PREEMPTION                    1
+ #if PAINEL_BAIXO_CONSUMO && !PAINEL_SMP
+ #define configUSE_TICKLESS_IDLE                 1
+ #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+ #else
  #define configUSE_TICKLESS_IDLE                 0
+ #endif
  #define configUSE_IDLE_HOOK                     0
  #define configUSE_TICK_HOOK                     0
  #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
@@ -63,24 +79,40 @@
  #define configUSE_NEWLIB_REENTRANT              0
  #define configENABLE_BACKWARD_COMPATIBILITY     0
  #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+ #define configTASK_NOTIFICATION_ARRAY_ENTRIES   2
  
  /* System */
  #define configSTACK_DEPTH_TYPE                  uint32_t
  #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
  
  /* Memory allocation related definitions. */
- #define configSUPPORT_STATIC_ALLOCATION         0
- #define configSUPPORT_DYNAMIC_ALLOCATION        1
- #define configTOTAL_HEAP_SIZE                   (128*1024)
+ /* Alocação só estática: tasks, pilhas e semáforos são objetos do main.c e
+    as pilhas da Idle/Timer vêm do próprio kernel; sem heap do FreeRTOS */
+ #define configSUPPORT_STATIC_ALLOCATION         1
+ #define configSUPPORT_DYNAMIC_ALLOCATION        0
+ #define configKERNEL_PROVIDED_STATIC_MEMORY     1
  #define configAPPLICATION_ALLOCATED_HEAP        0
  
  /* Hook function related definitions. */
  #define configCHECK_FOR_STACK_OVERFLOW          0
  #define configUSE_MALLOC_FAILED_HOOK            0
  #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+
+ /* Residência em sono do tickless idle (lib/Energia_Bibliotecas) */
+ #if configUSE_TICKLESS_IDLE
+ void energia_pre_sono(void);
+ void energia_pos_sono(void);
+ #define configPRE_SLEEP_PROCESSING(x)           energia_pre_sono()
+ #define configPOST_SLEEP_PROCESSING(x)          energia_pos_sono()
+ #endif
  
  /* Run time and task stats gathering related definitions. */
- #define configGENERATE_RUN_TIME_STATS           0
+ #define configGENERATE_RUN_TIME_STATS           1
+ /* Contador de µs do timer do RP2040, já ativo desde o boot; 32 bits dão a
+    volta em ~71 min, então o uso de CPU é calculado por diferença */
+ #include "hardware/timer.h"
+ #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+ #define portGET_RUN_TIME_COUNTER_VALUE()        time_us_32()
  #define configUSE_TRACE_FACILITY                1
  #define configUSE_STATS_FORMATTING_FUNCTIONS    0
  
@@ -102,7 +134,13 @@
  */
  
  /* SMP port only */
+ #if PAINEL_SMP
+ #define configNUM_CORES                         2
+ #define configUSE_CORE_AFFINITY                 1
+ #else
  #define configNUM_CORES                         1
+ #endif
+ #define configNUMBER_OF_CORES                   configNUM_CORES   /* nome no kernel V11 */
  #define configTICK_CORE                         1
  #define configRUN_MULTIPLE_PRIORITIES           1
  
@@ -0,0 +1,51 @@
+#include "latencia.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t balde_de(uint32_t us) {  // 0-3 diretos; depois (expoente, 2 bits de mantissa)
+    if (us < 4) return us;
+    uint32_t msb = 31u - (uint32_t)__builtin_clz(us);
+    uint32_t idx = (msb - 1u) * 4u + ((us >> (msb - 2u)) & 3u);
+    return idx < LATENCIA_BALDES ? idx : LATENCIA_BALDES - 1;
+}
+
+static uint32_t limite_do_balde(uint32_t idx) {  // Maior valor que cai no balde
+    if (idx < 4) return idx;
+    uint32_t msb = idx / 4u + 1u;
+    uint32_t base = (4u + idx % 4u) << (msb - 2u);
+    return base + (1u << (msb - 2u)) - 1u;
+}
+
+void latencia_registrar(latencia_hist_t *h, uint32_t us) {
+    ++h->contagem[balde_de(us)];
+    ++h->amostras;
+    if (us > h->max_us) h->max_us = us;
+}
+
+uint32_t latencia_percentil(const latencia_hist_t *h, uint32_t permil) {
+    if (h->amostras == 0) return 0;
+    uint64_t alvo = ((uint64_t)h->amostras * permil + 999u) / 1000u;  // Posição da amostra (1..n)
+    if (alvo == 0) alvo = 1;
+    uint64_t acumulado = 0;
+    for (uint32_t i = 0; i < LATENCIA_BALDES; ++i) {
+        acumulado += h->contagem[i];
+        if (acumulado >= alvo) {
+            if (i == LATENCIA_BALDES - 1) break;  // Último balde é aberto: só o máximo vale
+            uint32_t limite = limite_do_balde(i);
+            return limite < h->max_us ? limite : h->max_us;  // Nunca acima do máximo real
+        }
+    }
+    return h->max_us;
+}
+
+void latencia_zerar(latencia_hist_t *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+void latencia_imprimir(const char *nome, const latencia_hist_t *h) {
+    printf("%-10s n=%-6lu p50=%-8lu p99=%-8lu max=%lu us\n", nome,
+           (unsigned long)h->amostras,
+           (unsigned long)latencia_percentil(h, 500),
+           (unsigned long)latencia_percentil(h, 990),
+           (unsigned long)h->max_us);
+}
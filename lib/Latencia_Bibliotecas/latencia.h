@@ -0,0 +1,25 @@
+#ifndef LATENCIA_H
+#define LATENCIA_H
+
+#include <stdint.h>
+
+/* ---------- Histograma de latência em baldes fixos ----------
+ * Baldes log-lineares: valores 0-3 µs exatos e, acima disso, 4 baldes por
+ * potência de 2 (erro <= 25 %), com o último balde aberto (>= ~16 s). Registrar é O(1)
+ * e sem alocação, próprio para IRQ; cada histograma deve ter um único
+ * escritor (task ou IRQ). */
+#define LATENCIA_BALDES 96
+
+typedef struct {
+    uint32_t contagem[LATENCIA_BALDES];
+    uint32_t amostras;
+    uint32_t max_us;
+} latencia_hist_t;
+
+/* ---------- API ---------- */
+void     latencia_registrar(latencia_hist_t *h, uint32_t us);  // Conta uma amostra
+uint32_t latencia_percentil(const latencia_hist_t *h, uint32_t permil);  // Limite superior do balde (µs)
+void     latencia_zerar(latencia_hist_t *h);
+void     latencia_imprimir(const char *nome, const latencia_hist_t *h);  // n, p50, p99 e máx. no stdio
+
+#endif /* LATENCIA_H */
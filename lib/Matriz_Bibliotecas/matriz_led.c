@@ -1,5 +1,9 @@
 #include "matriz_led.h"
 #include <stdlib.h>
+#include <string.h>
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 
 const CorRGB PALETA_CORES[] = {
     {"Branco",  255, 255, 255},
@@ -16,96 +20,128 @@ const CorRGB PALETA_CORES[] = {
     {"---",       0,   0,   0}
 };
 
-const uint8_t PAD_OK[5]  = {0b00001,0b00010,0b00100,0b11000,0b10000};  // Padrão "✓" para verde
-const uint8_t PAD_EXC[5] = {0b00100,0b00100,0b00100,0b00000,0b00100};  // Padrão "!" para amarelo
-const uint8_t PAD_X[5]   = {0b10001,0b01010,0b00100,0b01010,0b10001};  // Padrão "X" para vermelho
-
-// Novos padrões de números (invertidos)
-const bool padrao_numeros[10][25] = {
-    // 0 (invertido)
-    {
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 1,
-        1, 0, 0, 0, 1,
-        1, 0, 0, 0, 1,
-        1, 1, 1, 1, 1
-    },
-    // 1 (invertido)
-    {
-        1, 1, 1, 1, 1,
-        0, 0, 1, 0, 0,
-        0, 0, 1, 0, 0,
-        0, 1, 1, 0, 0,
-        0, 0, 1, 0, 0
-    },
-    // 2 (invertido)
-    {
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 0,
-        1, 1, 1, 1, 1,
-        0, 0, 0, 0, 1,
-        1, 1, 1, 1, 1
-    },
-    // 3 (invertido)
-    {
-        1, 1, 1, 1, 1,
-        0, 0, 0, 0, 1,
-        1, 1, 1, 1, 1,
-        0, 0, 0, 0, 1,
-        1, 1, 1, 1, 1
-    },
-    // 4 (invertido)
-    {
-        1, 0, 0, 0, 0,
-        0, 0, 0, 0, 1,
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 1,
-        1, 0, 0, 0, 1
-    },
-    // 5 (invertido)
-    {
-        1, 1, 1, 1, 1,
-        0, 0, 0, 0, 1,
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 0,
-        1, 1, 1, 1, 1
-    },
-    // 6 (invertido)
-    {
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 1,
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 0,
-        1, 1, 1, 1, 1
-    },
-    // 7 (invertido)
-    {
-        1, 0, 0, 0, 0,
-        0, 0, 0, 0, 1,
-        1, 1, 1, 0, 0,
-        0, 0, 0, 0, 1,
-        1, 1, 1, 1, 1
-    },
-    // 8 (invertido)
-    {
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 1,
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 1,
-        1, 1, 1, 1, 1
-    },
-    // 9 (invertido)
-    {
-        1, 1, 1, 1, 1,
-        0, 0, 0, 0, 1,
-        1, 1, 1, 1, 1,
-        1, 0, 0, 0, 1,
-        1, 1, 1, 1, 1
-    }
+const padrao_t PAD_OK  = PADRAO(0b00001,0b00010,0b00100,0b11000,0b10000);  // Padrão "✓" para verde
+const padrao_t PAD_EXC = PADRAO(0b00100,0b00100,0b00100,0b00000,0b00100);  // Padrão "!" para amarelo
+const padrao_t PAD_X   = PADRAO(0b10001,0b01010,0b00100,0b01010,0b10001);  // Padrão "X" para vermelho
+
+// Dígitos 0-9 (linhas de cima para baixo, convertidos para a cadeia em compilação)
+const padrao_t padrao_numeros[10] = {
+    PADRAO(0b11111,
+           0b10001,
+           0b10001,
+           0b10001,
+           0b11111),  // 0
+    PADRAO(0b00100,
+           0b01100,
+           0b00100,
+           0b00100,
+           0b11111),  // 1
+    PADRAO(0b11111,
+           0b00001,
+           0b11111,
+           0b10000,
+           0b11111),  // 2
+    PADRAO(0b11111,
+           0b00001,
+           0b11111,
+           0b00001,
+           0b11111),  // 3
+    PADRAO(0b10001,
+           0b10001,
+           0b11111,
+           0b00001,
+           0b00001),  // 4
+    PADRAO(0b11111,
+           0b10000,
+           0b11111,
+           0b00001,
+           0b11111),  // 5
+    PADRAO(0b11111,
+           0b10000,
+           0b11111,
+           0b10001,
+           0b11111),  // 6
+    PADRAO(0b11111,
+           0b00001,
+           0b00111,
+           0b00001,
+           0b00001),  // 7
+    PADRAO(0b11111,
+           0b10001,
+           0b11111,
+           0b10001,
+           0b11111),  // 8
+    PADRAO(0b11111,
+           0b10001,
+           0b11111,
+           0b00001,
+           0b11111),   // 9
 };
 
-static inline void ws2812_put(uint32_t grb) {  // Envia dados GRB para um LED
-    pio_sm_put_blocking(pio0, 0, grb << 8u);  // Desloca 8 bits para alinhar protocolo WS2812
+/* ---------- Saída por DMA ---------- */
+
+/* O IRQ do DMA vem quando a última palavra entra no FIFO: ainda saem as 8
+   palavras do FIFO TX unido e a que está no OSR. Depois, a linha em nível
+   baixo pelo tempo de reset que trava o quadro: >= 280 us nos WS2812B atuais
+   (os antigos aceitavam 50 us) */
+#define MATRIZ_FIFO_PALAVRAS  8                                // PIO_FIFO_JOIN_TX
+#define MATRIZ_US_POR_LED     ((RGBW_ATIVO ? 32 : 24) * 5 / 4)  // 1,25 us por bit a 800 kHz
+#define MATRIZ_RESET_US       280
+#define MATRIZ_LATCH_US       ((MATRIZ_FIFO_PALAVRAS + 1) * MATRIZ_US_POR_LED + MATRIZ_RESET_US)
+
+static uint32_t quadro[NUM_PIXELS];        // Quadro em edição (GRB << 8)
+static uint32_t quadro_envio[NUM_PIXELS];  // Origem do DMA
+static uint32_t ultimo_quadro[NUM_PIXELS]; // Último quadro aceito por matriz_commit
+static bool     ultimo_valido = false;     // false até o primeiro commit
+
+/* Quadros de ocupação pré-calculados: 0-9 na cor de cada dígito, 10 = X vermelho */
+#define QUADROS_OCUPACAO  11
+static uint32_t quadros_ocupacao[QUADROS_OCUPACAO][NUM_PIXELS];
+static bool     ocupacao_pronta = false;
+static int8_t   ultima_ocupacao = -1;      // Índice do último quadro de ocupação enviado
+static int      dma_matriz = -1;
+static volatile bool envio_ativo = false;
+static volatile bool envio_pendente = false;
+static spin_lock_t *trava_envio = NULL;    // Estado do envio: tarefa e IRQ podem estar em núcleos diferentes
+static matriz_callback_t cb_envio = NULL;
+static void *cb_ctx = NULL;
+
+static void iniciar_envio(void) {  // Chamada com trava_envio adquirida
+    memcpy(quadro_envio, quadro, sizeof(quadro));
+    envio_ativo = true;
+    envio_pendente = false;
+    dma_channel_transfer_from_buffer_now(dma_matriz, quadro_envio, NUM_PIXELS);
+}
+
+static int64_t fim_latch(alarm_id_t id, void *dados) {  // Reset do WS2812 concluído
+    uint32_t irq = spin_lock_blocking(trava_envio);
+    envio_ativo = false;
+    if (envio_pendente) iniciar_envio();  // Quadro alterado durante o envio
+    spin_unlock(trava_envio, irq);
+    if (cb_envio) cb_envio(cb_ctx);  // Fora da trava
+    return 0;
+}
+
+static void irq_dma_matriz(void) {  // Último LED entrou no FIFO do PIO
+    if (dma_matriz < 0 || !dma_channel_get_irq0_status(dma_matriz)) return;
+    dma_channel_acknowledge_irq0(dma_matriz);
+    if (add_alarm_in_us(MATRIZ_LATCH_US, fim_latch, NULL, true) < 0) {
+        // Sem alarme livre: o quadro trava sozinho com a linha parada, mas nada
+        // liberaria o envio. Libera já; um quadro pendente sai no próximo commit.
+        uint32_t irq = spin_lock_blocking(trava_envio);
+        envio_ativo = false;
+        spin_unlock(trava_envio, irq);
+    }
+}
+
+static inline void quadro_set(int i, uint32_t grb) {  // Grava LED i no quadro
+    quadro[i] = grb << 8u;  // Desloca 8 bits para alinhar protocolo WS2812
+}
+
+static void pintar_padrao(uint32_t *dst, padrao_t pad, uint32_t cor_on) {  // Padrão → quadro, sem desvios
+    uint32_t cor = cor_on << 8u;
+    for (int i = 0; i < NUM_PIXELS; ++i)
+        dst[i] = cor & -((pad >> i) & 1u);  // Bit 1 → cor, bit 0 → apagado
 }
 
 void inicializar_matriz_led(void) {  // Configura PIO para controlar WS2812
@@ -113,34 +149,80 @@ void inicializar_matriz_led(void) {  // Configura PIO para controlar WS2812
     uint off = pio_add_program(pio, &ws2812_program);  // Carrega programa PIO
     ws2812_program_init(pio, 0, off, PINO_WS2812, 800000, RGBW_ATIVO);  // Inicia PIO a 800kHz
     srand(to_us_since_boot(get_absolute_time()));  // Inicializa semente para rand()
+    trava_envio = spin_lock_init(spin_lock_claim_unused(true));
+
+    /* DMA: quadro de 25 palavras -> FIFO TX da SM 0, no ritmo do DREQ do PIO */
+    dma_matriz = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_matriz);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, 0, true));
+    dma_channel_configure(dma_matriz, &c, &pio->txf[0], quadro_envio, NUM_PIXELS, false);
+
+    dma_channel_set_irq0_enabled(dma_matriz, true);
+    irq_add_shared_handler(DMA_IRQ_0, irq_dma_matriz, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
 }
 
-void matriz_draw_pattern(const uint8_t pad[5], uint32_t cor_on) {  // Desenha padrão na matriz
-    /* placa montada "de cabeça-para-baixo" → linha 4 primeiro */
-    for (int lin = 4; lin >= 0; --lin) {
-        for (int col = 0; col < 5; ++col) {
-            bool aceso = pad[lin] & (1 << (4 - col));  // Verifica bit do padrão
-            ws2812_put(aceso ? cor_on : COR_OFF);  // Aplica cor ou desliga LED
-        }
-    }
-    sleep_us(60);  // Latência para atualizar matriz
+void matriz_set_callback(matriz_callback_t cb, void *ctx) {  // Aviso de quadro exibido
+    cb_envio = cb;
+    cb_ctx = ctx;
+}
+
+bool matriz_commit(void) {  // Envia o quadro sem bloquear
+    ultima_ocupacao = -1;  // Quadro desenhado fora do cache de ocupação
+    if (ultimo_valido && !envio_pendente && memcmp(quadro, ultimo_quadro, sizeof(quadro)) == 0)
+        return true;  // Igual ao último quadro: nada a retransmitir
+    memcpy(ultimo_quadro, quadro, sizeof(quadro));
+    ultimo_valido = true;
+
+    uint32_t irq = spin_lock_blocking(trava_envio);  // Também desabilita IRQs neste núcleo
+    bool iniciou = !envio_ativo;
+    if (iniciou) iniciar_envio();
+    else envio_pendente = true;  // Reenviado ao fim do envio atual
+    spin_unlock(trava_envio, irq);
+    return iniciou;
+}
+
+bool matriz_busy(void) {  // Há quadro em envio ou aguardando envio
+    return envio_ativo || envio_pendente;
+}
+
+void matriz_draw_pattern(padrao_t pad, uint32_t cor_on) {  // Desenha padrão na matriz
+    pintar_padrao(quadro, pad, cor_on);
+    matriz_commit();
 }
 
 void matriz_draw_number(uint8_t numero, uint32_t cor_on) {  // Desenha um número na matriz
     if (numero > 9) {
         matriz_draw_pattern(PAD_X, COR_VERMELHO);  // Desenha "X" vermelho se o número for maior que 9
     } else {
-        /* O formato da matriz boolean requer uma lógica diferente para desenhar */
-        for (int lin = 0; lin < 5; ++lin) {
-            for (int col = 0; col < 5; ++col) {
-                bool aceso = padrao_numeros[numero][lin * 5 + col];
-                ws2812_put(aceso ? cor_on : COR_OFF);
-            }
-        }
-        sleep_us(60);  // Latência para atualizar matriz
+        matriz_draw_pattern(padrao_numeros[numero], cor_on);
     }
 }
 
+void matriz_cache_occupancy(const uint32_t cores[10]) {  // Pré-calcula os 11 quadros de ocupação
+    for (int n = 0; n < 10; ++n)
+        pintar_padrao(quadros_ocupacao[n], padrao_numeros[n], cores[n]);
+    pintar_padrao(quadros_ocupacao[10], PAD_X, COR_VERMELHO);
+    ocupacao_pronta = true;
+    ultima_ocupacao = -1;
+}
+
+bool matriz_draw_occupancy(uint8_t ocupacao) {  // Exibe 0-9 ou X (>= 10) a partir do cache
+    int8_t idx = (ocupacao > 9) ? 10 : (int8_t)ocupacao;
+    // Caminho comum: mesmo quadro, nada a fazer. Com envio pendente (alarme do
+    // latch indisponível), o commit abaixo é que o tira da fila
+    if (idx == ultima_ocupacao && !envio_pendente) return false;
+    if (!ocupacao_pronta) return false;
+
+    memcpy(quadro, quadros_ocupacao[idx], sizeof(quadro));
+    matriz_commit();
+    ultima_ocupacao = idx;
+    return true;
+}
+
 void matriz_draw_rain_animation(uint32_t cor_on) {
     static uint8_t gotas[5] = {0};  // Posição Y de cada gota por coluna (0 a 4, 0=desligada)
     static uint32_t ultimo_tempo = 0;
@@ -148,9 +230,6 @@ void matriz_draw_rain_animation(uint32_t cor_on) {
 
     // Atualiza a cada 50ms para movimento mais rápido
     if (tempo_atual - ultimo_tempo >= 50) {
-        // Limpa a matriz
-        matriz_clear();
-
         // Atualiza posição das gotas
         for (int col = 0; col < 5; col++) {
             if (gotas[col] > 0) {
@@ -162,27 +241,22 @@ void matriz_draw_rain_animation(uint32_t cor_on) {
             }
         }
 
-        // Desenha gotas
+        // Desenha todas as gotas em um único quadro
+        for (int i = 0; i < NUM_PIXELS; i++) quadro_set(i, COR_OFF);
         for (int col = 0; col < 5; col++) {
             if (gotas[col] > 0) {
                 // Calcula índice do LED (matriz invertida: linha 4 - (gotas[col] - 1))
                 int lin = 4 - (gotas[col] - 1);
-                for (int i = 0; i < NUM_PIXELS; i++) {
-                    if (i == lin * 5 + col) {
-                        ws2812_put(cor_on);  // Acende o LED da gota
-                    } else {
-                        ws2812_put(COR_OFF);  // Desliga os outros LEDs
-                    }
-                }
+                quadro_set(lin * 5 + col, cor_on);  // Acende o LED da gota
             }
         }
-        sleep_us(60);  // Latência para atualizar matriz
+        matriz_commit();
         ultimo_tempo = tempo_atual;
     }
 }
 
 void matriz_clear(void) {  // Limpa todos os LEDs
     for (int i = 0; i < NUM_PIXELS; ++i)
-        ws2812_put(COR_OFF);  // Desliga cada LED
-    sleep_us(60);  // Latência para confirmar limpeza
-}
\ No newline at end of file
+        quadro_set(i, COR_OFF);  // Desliga cada LED
+    matriz_commit();
+}
@@ -39,18 +39,38 @@ extern const CorRGB PALETA_CORES[];
 #define COR_VERMELHO  GRB(190, 0, 0)     // Vermelho
 #define COR_OFF       GRB(0, 0, 0)        // Desliga LEDs
 
-/* ---------- Padrões 5 × 5 (✓, !, X) ---------- */
-extern const uint8_t PAD_OK[5];   // Padrão "✓" para verde
-extern const uint8_t PAD_EXC[5];  // Padrão "!" para amarelo
-extern const uint8_t PAD_X[5];    // Padrão "X" para vermelho
+/* ---------- Padrões 5 × 5: 25 bits, bit i = LED i da cadeia ---------- */
+typedef uint32_t padrao_t;
 
-/* ---------- Padrões para dígitos 0-9 (novo formato) ---------- */
-extern const bool padrao_numeros[10][25];  // Array 2D com padrões dos números 0-9
+/* PADRAO() recebe as 5 linhas como são vistas (linha 0 = topo, bit 4 = coluna
+   da esquerda) e resolve a montagem em tempo de compilação: a placa está "de
+   cabeça-para-baixo" (a linha de baixo é a primeira da cadeia) e a cadeia é
+   serpentina (linhas pares da cadeia correm da direita para a esquerda). */
+#define PADRAO_REV5(b)      ( (((b) & 0x01) << 4) | (((b) & 0x02) << 2) | ((b) & 0x04) | \
+                              (((b) & 0x08) >> 2) | (((b) & 0x10) >> 4) )
+#define PADRAO_LINHA(r, b)  ( (uint32_t)((((r) % 2) == 0) ? (b) : PADRAO_REV5(b)) << (5 * (4 - (r))) )
+#define PADRAO(r0, r1, r2, r3, r4) \
+    ( PADRAO_LINHA(0, r0) | PADRAO_LINHA(1, r1) | PADRAO_LINHA(2, r2) | \
+      PADRAO_LINHA(3, r3) | PADRAO_LINHA(4, r4) )
+
+extern const padrao_t PAD_OK;   // Padrão "✓" para verde
+extern const padrao_t PAD_EXC;  // Padrão "!" para amarelo
+extern const padrao_t PAD_X;    // Padrão "X" para vermelho
+
+/* ---------- Padrões para dígitos 0-9 ---------- */
+extern const padrao_t padrao_numeros[10];
 
 /* ---------- API ---------- */
-void inicializar_matriz_led(void);  // Inicializa PIO para WS2812
-void matriz_draw_pattern(const uint8_t pad[5], uint32_t cor_on);  // Desenha padrão na matriz
+typedef void (*matriz_callback_t)(void *ctx);  // Chamada na IRQ quando o quadro foi travado
+
+void inicializar_matriz_led(void);  // Inicializa PIO + DMA para WS2812
+bool matriz_commit(void);  // Envia o quadro por DMA sem bloquear (false = enfileirado atrás do envio atual)
+void matriz_set_callback(matriz_callback_t cb, void *ctx);  // Registra aviso de fim de envio
+bool matriz_busy(void);  // true enquanto há quadro em envio ou pendente
+void matriz_draw_pattern(padrao_t pad, uint32_t cor_on);  // Desenha padrão na matriz
 void matriz_draw_number(uint8_t numero, uint32_t cor_on);  // Desenha número (0-9) na matriz
+void matriz_cache_occupancy(const uint32_t cores[10]);  // Pré-calcula quadros 0-9 (cores[n]) e X vermelho
+bool matriz_draw_occupancy(uint8_t ocupacao);  // Exibe quadro pré-calculado (>= 10 → X); false = repetição ignorada
 void matriz_draw_rain_animation(uint32_t cor_on);  // Desenha animação de chuva
 void matriz_clear(void);  // Limpa todos os LEDs
 
@@ -0,0 +1,76 @@
+#include "telemetria_bin.h"
+#include <string.h>
+#include "pico/stdlib.h"
+
+_Static_assert(sizeof(tbin_ocupacao_t) <= TBIN_PAYLOAD_MAX, "payload de ocupação grande demais");
+_Static_assert(sizeof(tbin_task_t)     <= TBIN_PAYLOAD_MAX, "payload de task grande demais");
+_Static_assert(sizeof(tbin_latencia_t) <= TBIN_PAYLOAD_MAX, "payload de latência grande demais");
+
+#define TBIN_BRUTO_MAX   (2 + TBIN_PAYLOAD_MAX + 2)           // tipo, seq, payload, CRC
+#define TBIN_LINHA_MAX   (1 + TBIN_BRUTO_MAX + 1 + 1)         // 0x00, COBS (+1 B até 254 B), 0x00
+
+// Só o escritor único mexe
+static uint8_t  bruto[TBIN_BRUTO_MAX];
+static uint8_t  linha[TBIN_LINHA_MAX];
+static uint8_t  seq;
+static uint32_t quadros;
+static uint32_t bytes;
+
+uint16_t tbin_crc16(const uint8_t *dados, uint32_t n) {
+    // Bit a bit: cabe em poucas instruções no M0+ e os quadros têm ~30 B
+    uint16_t crc = 0xFFFF;
+    for (uint32_t i = 0; i < n; ++i) {
+        crc ^= (uint16_t)dados[i] << 8;
+        for (int b = 0; b < 8; ++b)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+uint32_t tbin_cobs(const uint8_t *dados, uint32_t n, uint8_t *saida) {
+    uint32_t cod = 0;        // Posição do byte de código do bloco atual
+    uint32_t o   = 1;
+    uint8_t  bloco = 1;      // Distância até o próximo zero (código)
+    for (uint32_t i = 0; i < n; ++i) {
+        if (dados[i] == 0) {
+            saida[cod] = bloco;
+            cod = o++;
+            bloco = 1;
+        } else {
+            saida[o++] = dados[i];
+            if (++bloco == 0xFF) {   // Bloco cheio sem zero: fecha e abre outro
+                saida[cod] = bloco;
+                cod = o++;
+                bloco = 1;
+            }
+        }
+    }
+    saida[cod] = bloco;
+    return o;
+}
+
+void tbin_enviar(tbin_tipo_t tipo, const void *payload, uint32_t n) {
+    if (n > TBIN_PAYLOAD_MAX) return;
+
+    bruto[0] = (uint8_t)tipo;
+    bruto[1] = seq++;
+    memcpy(&bruto[2], payload, n);
+    uint16_t crc = tbin_crc16(bruto, 2 + n);
+    bruto[2 + n] = (uint8_t)crc;
+    bruto[3 + n] = (uint8_t)(crc >> 8);
+
+    uint32_t len = 0;
+    linha[len++] = 0x00;   // Fecha qualquer lixo anterior (texto, quadro truncado)
+    len += tbin_cobs(bruto, 4 + n, &linha[len]);
+    linha[len++] = 0x00;
+
+    // Uma chamada só: o mutex do stdio impede que um printf corte o quadro
+    stdio_put_string((const char *)linha, (int)len, false, false);
+    ++quadros;
+    bytes += len;
+}
+
+void tbin_estatisticas(tbin_stats_t *st) {
+    st->quadros = quadros;
+    st->bytes   = bytes;
+}
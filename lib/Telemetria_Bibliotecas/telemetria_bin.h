@@ -0,0 +1,73 @@
+#ifndef TELEMETRIA_BIN_H
+#define TELEMETRIA_BIN_H
+
+#include <stdint.h>
+
+/* ---------- Telemetria binária enquadrada (COBS + CRC-16) ----------
+ * Cada quadro é [tipo][seq][payload][crc16 LE], codificado em COBS e
+ * cercado por bytes 0x00: o decodificador se ressincroniza no próximo zero
+ * mesmo com texto do printf intercalado no mesmo CDC, e o CRC-16/CCITT-FALSE
+ * (sobre tipo, seq e payload) descarta o que vier truncado. 'seq' conta os
+ * quadros enviados (mod 256), para o host contar as perdas.
+ * Montado num buffer estático, sem printf e sem tradução de CR/LF; um único
+ * escritor (a task de telemetria). Payloads little-endian, sem padding. */
+#define TBIN_PAYLOAD_MAX  32
+
+typedef enum {
+    TBIN_OCUPACAO = 1,   // tbin_ocupacao_t: zona cuja ocupação mudou
+    TBIN_TASK     = 2,   // tbin_task_t: uma task, CPU na janela e pilha
+    TBIN_LATENCIA = 3,   // tbin_latencia_t: resumo de uma etapa de latência
+    TBIN_DISPLAY  = 4    // tbin_display_t: comandos, quadros e envios do OLED
+} tbin_tipo_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t ts_ms;       // Tick do FreeRTOS (1 kHz)
+    uint8_t  zona;
+    uint16_t ocupacao;    // Satura em 65535
+    uint16_t capacidade;  // Satura em 65535
+    uint32_t entradas;
+    uint32_t saidas;
+    uint32_t recusas;
+} tbin_ocupacao_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t ts_ms;
+    uint8_t  numero;       // xTaskNumber
+    uint8_t  prioridade;
+    uint16_t cpu_permil;   // Uso na janela desde o último relatório (0,1 %)
+    uint16_t pilha_livre;  // Mínimo histórico, em bytes
+    char     nome[12];     // Sem terminador se ocupar os 12
+} tbin_task_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t ts_ms;
+    uint8_t  etapa;        // Índice da etapa no firmware (etapa_latencia_t)
+    uint32_t amostras;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} tbin_latencia_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t ts_ms;
+    uint32_t comandos;          // Recebidos pela task do display
+    uint32_t fundidos;          // Absorvidos por um bit já pendente
+    uint32_t quadros;           // Desenhados
+    uint32_t sobrepostos;       // Desenhados com o envio anterior em curso
+    uint32_t flush_iniciados;   // Envios ao OLED; em curso = iniciados - concluidos
+    uint32_t flush_concluidos;  // Inclui os cancelados
+    uint32_t flush_cancelados;
+} tbin_display_t;
+
+typedef struct {
+    uint32_t quadros;   // Enviados desde o boot
+    uint32_t bytes;     // Na linha, com COBS e delimitadores
+} tbin_stats_t;
+
+/* ---------- API ---------- */
+void     tbin_enviar(tbin_tipo_t tipo, const void *payload, uint32_t n);  // n <= TBIN_PAYLOAD_MAX
+uint16_t tbin_crc16(const uint8_t *dados, uint32_t n);                   // CRC-16/CCITT-FALSE
+uint32_t tbin_cobs(const uint8_t *dados, uint32_t n, uint8_t *saida);    // Retorna o tamanho codificado
+void     tbin_estatisticas(tbin_stats_t *st);
+
+#endif /* TELEMETRIA_BIN_H */
@@ -0,0 +1,28 @@
+#include "vagas.h"
+
+void vagas_init(vagas_t *v, uint32_t capacidade) {
+    v->capacidade = capacidade;
+    atomic_store_explicit(&v->ocupacao, 0, memory_order_release);
+}
+
+bool vagas_try_enter(vagas_t *v) {
+    uint32_t atual = atomic_load_explicit(&v->ocupacao, memory_order_relaxed);
+    do {
+        if (atual >= v->capacidade) return false;  // Lotado: nada é alterado
+    } while (!atomic_compare_exchange_weak_explicit(&v->ocupacao, &atual, atual + 1,
+                                                    memory_order_acq_rel, memory_order_relaxed));
+    return true;
+}
+
+bool vagas_exit(vagas_t *v) {
+    uint32_t atual = atomic_load_explicit(&v->ocupacao, memory_order_relaxed);
+    do {
+        if (atual == 0) return false;  // Vazio: não deixa a ocupação ficar negativa
+    } while (!atomic_compare_exchange_weak_explicit(&v->ocupacao, &atual, atual - 1,
+                                                    memory_order_acq_rel, memory_order_relaxed));
+    return true;
+}
+
+uint32_t vagas_reset(vagas_t *v) {
+    return atomic_exchange_explicit(&v->ocupacao, 0, memory_order_acq_rel);
+}
@@ -0,0 +1,28 @@
+#ifndef VAGAS_H
+#define VAGAS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/* ---------- Contador de admissão sem locks ----------
+ * Ocupação e capacidade num único contador atômico: entrada, saída e reset
+ * são O(1), sem chamadas ao kernel, e podem ser usados de qualquer task ou
+ * IRQ. No RP2040 (Cortex-M0+, sem LDREX/STREX) as operações atômicas do C11
+ * vêm da biblioteca pico_atomic do SDK. */
+typedef struct {
+    _Atomic uint32_t ocupacao;
+    uint32_t capacidade;
+} vagas_t;
+
+/* ---------- API ---------- */
+void     vagas_init(vagas_t *v, uint32_t capacidade);  // Zera a ocupação
+bool     vagas_try_enter(vagas_t *v);  // Ocupa uma vaga; false se lotado (nunca excede a capacidade)
+bool     vagas_exit(vagas_t *v);       // Libera uma vaga; false se já estava vazio
+uint32_t vagas_reset(vagas_t *v);      // Zera a ocupação e retorna quantas vagas estavam ocupadas
+
+static inline uint32_t vagas_ocupacao(vagas_t *v) {  // Leitura instantânea da ocupação
+    return atomic_load_explicit(&v->ocupacao, memory_order_acquire);
+}
+
+#endif /* VAGAS_H */
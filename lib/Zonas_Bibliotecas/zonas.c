@@ -0,0 +1,35 @@
+#include "zonas.h"
+
+void zona_init(zona_t *z, const char *nome, uint32_t capacidade) {
+    z->nome = nome;
+    vagas_init(&z->vagas, capacidade);
+    atomic_store_explicit(&z->entradas, 0, memory_order_relaxed);
+    atomic_store_explicit(&z->saidas,   0, memory_order_relaxed);
+    atomic_store_explicit(&z->recusas,  0, memory_order_relaxed);
+    atomic_store_explicit(&z->resets,   0, memory_order_relaxed);
+}
+
+bool zona_entrar(zona_t *z) {
+    if (vagas_try_enter(&z->vagas)) {
+        atomic_fetch_add_explicit(&z->entradas, 1, memory_order_relaxed);
+        return true;
+    }
+    atomic_fetch_add_explicit(&z->recusas, 1, memory_order_relaxed);
+    return false;
+}
+
+bool zona_sair(zona_t *z) {
+    if (!vagas_exit(&z->vagas)) return false;
+    atomic_fetch_add_explicit(&z->saidas, 1, memory_order_relaxed);
+    return true;
+}
+
+void zona_restaurar(zona_t *z, uint32_t ocupacao) {
+    if (ocupacao > z->vagas.capacidade) ocupacao = z->vagas.capacidade;
+    atomic_store_explicit(&z->vagas.ocupacao, ocupacao, memory_order_release);
+}
+
+uint32_t zona_zerar(zona_t *z) {
+    atomic_fetch_add_explicit(&z->resets, 1, memory_order_relaxed);
+    return vagas_reset(&z->vagas);
+}
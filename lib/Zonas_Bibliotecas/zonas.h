@@ -0,0 +1,40 @@
+#ifndef ZONAS_H
+#define ZONAS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "vagas.h"
+
+/* ---------- Zona de ocupação ----------
+ * Cada zona tem capacidade e contadores próprios em memória fixa: entrada,
+ * saída e reset tocam só a zona indicada (O(1)), então o custo por evento
+ * não cresce com o número de zonas. Os contadores são atômicos como a
+ * ocupação, e podem ser atualizados de qualquer task. */
+typedef struct {
+    const char *nome;
+    vagas_t vagas;                 // Ocupação/capacidade (uint32_t)
+    _Atomic uint32_t entradas;     // Entradas admitidas
+    _Atomic uint32_t saidas;       // Saídas com a zona não vazia
+    _Atomic uint32_t recusas;      // Entradas recusadas por lotação
+    _Atomic uint32_t resets;
+} zona_t;
+
+/* ---------- API ---------- */
+void     zona_init(zona_t *z, const char *nome, uint32_t capacidade);  // Zera ocupação e contadores
+bool     zona_entrar(zona_t *z);   // Admite se houver vaga; recusa conta em 'recusas'
+bool     zona_sair(zona_t *z);     // false se já estava vazia
+uint32_t zona_zerar(zona_t *z);    // Reset: zera a ocupação e retorna quantos estavam dentro
+void     zona_restaurar(zona_t *z, uint32_t ocupacao);  // Ocupação salva (boot), limitada à capacidade
+
+static inline uint32_t zona_ocupacao(zona_t *z)   { return vagas_ocupacao(&z->vagas); }
+static inline uint32_t zona_capacidade(const zona_t *z) { return z->vagas.capacidade; }
+
+// Nível em décimos da capacidade para indicadores de um dígito:
+// 0-9 enquanto há vaga (arredondado para baixo) e 10 quando lotada
+static inline uint8_t zona_nivel(uint32_t ocupacao, uint32_t capacidade) {
+    if (ocupacao >= capacidade) return 10;
+    return (uint8_t)((uint64_t)ocupacao * 10u / capacidade);
+}
+
+#endif /* ZONAS_H */
@@ -1,14 +1,29 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"                
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
-#include "queue.h"
 #include "hardware/gpio.h"
 #include "hardware/i2c.h"
 #include "lib/Display_Bibliotecas/ssd1306.h"
 #include "lib/Matriz_Bibliotecas/matriz_led.h"
+#include "lib/Zonas_Bibliotecas/zonas.h"
+#include "lib/Eventos_Bibliotecas/eventos.h"
+#include "lib/Contadores_Bibliotecas/contadores.h"
+#include "lib/Flash_Bibliotecas/layout_flash.h"
+#include "lib/Energia_Bibliotecas/energia.h"
+#include "lib/Latencia_Bibliotecas/latencia.h"
+#include "lib/Telemetria_Bibliotecas/telemetria_bin.h"
+#include "lib/Bench_Bibliotecas/bench.h"
+
+/* configKERNEL_PROVIDED_STATIC_MEMORY (FreeRTOSConfig.h) só existe a partir do
+   V11.1: em kernels anteriores faltariam as pilhas da Idle e da Timer no link */
+#if tskKERNEL_VERSION_MAJOR < 11 || (tskKERNEL_VERSION_MAJOR == 11 && tskKERNEL_VERSION_MINOR < 1)
+#error "FreeRTOS-Kernel V11.1 ou posterior: configKERNEL_PROVIDED_STATIC_MEMORY"
+#endif
 
 /* --------------------------------------------------------------------------- */
 /* 1. Mapeamento de hardware                                                   */
@@ -16,7 +31,9 @@
 #define PINO_BTN_ENTRADA      5     // Botão A
 #define PINO_BTN_SAIDA        6     // Botão B
 #define PINO_JOYSTICK_RESET   22
-#define MAX_USUARIOS          10
+#define MAX_USUARIOS          10    // capacidade da zona 0 (a sala do painel)
+#define MAX_AVATARES          10    // zonas até este tamanho têm tela de avatares
+#define NUM_ZONAS             3     // tabela em zonas_cfg (seção 3)
 
 /* Display OLED (SSD1306) */
 #define I2C_PORT              i2c1
@@ -35,40 +52,147 @@
 #define PINO_BUZZER           10
 #define PWM_FREQUENCIA_BUZZER 2000   // 2 kHz
 
+/* Baixo consumo: sem entradas por este tempo, OLED e matriz se apagam */
+#define INATIVIDADE_APAGAR_MS 30000  // 0 = nunca apaga
+
+/* Telemetria periódica no stdio (USB/UART) */
+#define TELEMETRIA_MS         5000   // 0 = só sob demanda (comando 't')
+#define TELEMETRIA_MAX_TASKS  16     // potência de 2: índice por xTaskNumber
+#define TELEMETRIA_BIN_MS     100    // modo binário ('b'): amostragem da ocupação
+
+/* Gerador de carga pelo stdio ('g'): eventos injetados a taxa fixa */
+#define CARGA_LOTE_MAX        64     // eventos por tipo e por tick; o excedente conta como atraso
+#define CARGA_MAX_S           3600   // duração máxima de um teste (time_us_32 dá a volta em ~71 min)
+
+/* Flash: período em que a task_flash drena o log de eventos (anel de
+   EVENTOS_ANEL registros → setor em RAM, gravado quando enche) e em que
+   grava os contadores persistentes que mudaram */
+#define EVENTOS_DRENO_MS      1000
+#define CONTADORES_PERIODO_MS 5000   // ~8 B por contador alterado a cada período
+
+/* Build de benchmark (-DPAINEL_BENCH=1): só a task_bench roda, mede e encerra */
+#ifndef PAINEL_BENCH
+#define PAINEL_BENCH          0
+#endif
+
 /* --------------------------------------------------------------------------- */
-/* 2. Tipos, enuns e tamanhos de filas                                         */
+/* 2. Tipos, enuns e canais de notificação                                     */
 /* --------------------------------------------------------------------------- */
 typedef enum {
     CMD_ATUALIZAR_TELA,
     CMD_MOSTRAR_MSG_RESET,
     CMD_OCULTAR_MSG_RESET,
-    CMD_ALTERNAR_TELA
+    CMD_ALTERNAR_TELA,
+    CMD_APAGAR_TELA,
+    CMD_ACENDER_TELA
 } comando_display_t;
 
-#define TAM_FILA_DISPLAY      5
+/* Retrato do painel consumido pelo renderizador: tudo que um quadro mostra,
+   lido de uma vez para que texto, LEDs e matriz nunca discordem entre si */
+typedef struct {
+    uint8_t  zona;               // zona ativa: botões, joystick, LEDs e matriz
+    uint32_t usuarios;           // ocupação da zona ativa
+    uint32_t capacidade;
+    uint8_t  pagina;             // 0 = estatísticas; n = medidor da zona n-1
+    uint32_t usuarios_pagina;    // ocupação e capacidade da zona da página
+    uint32_t capacidade_pagina;
+    uint32_t total_resets;
+    bool     mostrar_msg_reset;
+    bool     tela_apagada;
+} painel_state_t;
+
+/* Chaves dos contadores persistentes (lib/Contadores_Bibliotecas) */
+#define CONT_RESETS           0
+#define CONT_OCUPACAO(zona)   (1 + (zona))
+_Static_assert(CONT_OCUPACAO(NUM_ZONAS) <= CONTADORES_CHAVES, "chaves de contador insuficientes");
+
+/* Índices de notificação da task_display */
+#define NOTIF_COMANDOS        0     // bit (1 << comando_display_t) por comando pendente
+#define NOTIF_FLUSH_OLED      1     // fim do envio DMA do OLED
+
+/* Afinidade no build SMP: o núcleo 0 recebe as IRQs de GPIO (habilitadas no
+   main) e fica com toda a entrada; o núcleo 1 só renderiza e envia quadros */
+#if configNUM_CORES > 1
+#define NUCLEO_ENTRADA        (1u << 0)   // botões, admissão, reset, alternância
+#define NUCLEO_SAIDA          (1u << 1)   // task_display: OLED e matriz
+#endif
 
 /* --------------------------------------------------------------------------- */
-/* 3. Variáveis globais protegidas por mutex                                   */
+/* 3. Estado global                                                            */
 /* --------------------------------------------------------------------------- */
-volatile uint8_t  usuarios_ativos   = 0;    // 0-10
-volatile uint32_t total_resets      = 0;
+/* Zonas: capacidade e contadores por zona, ocupação atômica (sem mutex) */
+static const struct { const char *nome; uint32_t capacidade; } zonas_cfg[NUM_ZONAS] = {
+    { "Sala",  MAX_USUARIOS },
+    { "Audit", 250 },
+    { "Patio", 2000 },
+};
+static zona_t     zonas[NUM_ZONAS];
+volatile uint8_t  zona_ativa        = 0;    // escrita só pela task_telemetria (teclas 1-9)
+_Atomic uint32_t  total_resets      = 0;    // task_reset e gerador de carga
 volatile bool     mostrar_msg_reset = false;
-volatile bool     tela_stats_ativa  = true; // true = Estatísticas, false = Avatares
+volatile uint8_t  pagina_tela       = 0;    // 0 = Estatísticas, n = zona n-1 (avatares/medidor)
+volatile bool     tela_apagada      = false;// escrito só pela task_alternar_tela
+static volatile TickType_t ultima_atividade = 0;  // tick da última entrada do usuário
+
+/* Publicação do retrato (seqlock): seq ímpar = escrita em andamento */
+static painel_state_t   painel;
+static _Atomic uint32_t painel_seq = 0;
+
+/* Latência borda → pixel, medida a partir da borda da IRQ; cada histograma
+   tem um único escritor (task ou IRQ). Dump no stdio: 'l' mostra, 'z' zera */
+typedef enum {
+    LAT_ENTRADA,    // borda A/B → decisão de admissão (task_botoes)
+    LAT_RESET,      // borda do joystick → contagem zerada (task_reset)
+    LAT_DESPACHO,   // borda → task_display acorda com o comando
+    LAT_RENDER,     // borda → quadro desenhado no buffer
+    LAT_OLED,       // borda → fim do envio DMA do OLED (IRQ)
+    LAT_MATRIZ,     // borda → quadro da matriz exibido (alarme do latch)
+    LAT_CARGA,      // evento injetado → decisão (task_carga)
+    LAT_ETAPAS
+} etapa_latencia_t;
+
+static latencia_hist_t latencias[LAT_ETAPAS];
+static const char *const nomes_latencia[LAT_ETAPAS] = {
+    "Entrada", "Reset", "Despacho", "Render", "OLED", "Matriz", "Carga"
+};
+static _Atomic uint32_t  ts_evento_us    = 0;  // borda mais antiga ainda não desenhada (0 = nenhuma)
+static volatile uint32_t ts_envio_oled   = 0;  // borda do quadro em envio no OLED
+static volatile uint32_t ts_envio_matriz = 0;  // borda do quadro em envio na matriz
 
 /* --------------------------------------------------------------------------- */
 /* 4.  FreeRTOS (mutexes, semáforos, filas)                                    */
 /* --------------------------------------------------------------------------- */
-static SemaphoreHandle_t mtx_usuarios;
 static SemaphoreHandle_t mtx_oled;
 static SemaphoreHandle_t sem_reset_irq;
-static SemaphoreHandle_t sem_vagas;        // counting semaphore
-static QueueHandle_t     fila_display;
+static StaticSemaphore_t mtx_oled_mem;
+static StaticSemaphore_t sem_reset_irq_mem;
+static TaskHandle_t      tarefa_display;   // comandos + fim do envio DMA do OLED
+static TaskHandle_t      tarefa_alternar;  // acordada por entradas com o painel apagado
+static TaskHandle_t      tarefa_carga;     // gerador de carga, acordado pelo comando 'g'
+
+/* TCB e pilha de cada task, reservados em tempo de compilação (sem heap) */
+#define PILHA_TASK            1024   // palavras (4 KB)
+#define TASK_ESTATICA(nome, palavras) \
+    static StaticTask_t tcb_##nome;   \
+    static StackType_t  pilha_##nome[palavras]
+#define PALAVRAS(pilha)       (sizeof(pilha) / sizeof((pilha)[0]))
+
+/* Contadores do canal de comandos do display: display_comando roda em várias
+   tasks (e núcleos no SMP), então o incremento é atômico */
+static _Atomic uint32_t  cmds_display      = 0;  // comandos recebidos
+static _Atomic uint32_t  cmds_fundidos     = 0;  // comandos cujo bit já estava pendente
+static _Atomic uint32_t  cmds_descartados  = 0;  // comandos sem task_display (antes do início)
+static volatile uint32_t quadros_desenhados = 0; // desenhos da task_display (única escritora)
 
 /* --------------------------------------------------------------------------- */
 /* 5. Instâncias e utilidades                                                  */
 /* --------------------------------------------------------------------------- */
 static ssd1306_t oled;
 
+static bool     envio_oled_pendente = false;   // DMA do quadro anterior ainda não confirmado
+static uint32_t renders_sobrepostos = 0;       // quadros desenhados durante um envio em curso
+static uint32_t quadros_nao_enviados = 0;      // envio recusado com o DMA ainda ocupado
+
 static uint slice_buzzer;
 static uint channel_buzzer;
 
@@ -77,186 +201,411 @@ static inline void buzzer_on(void)  { pwm_set_enabled(slice_buzzer, true);  }
 static inline void buzzer_off(void) { pwm_set_enabled(slice_buzzer, false); }
 
 /* --------------------------------------------------------------------------- */
-/* 6. Utilitário de cor p/ matriz 5×5                                          */
+/* 6. Paleta da matriz 5×5 (cor de cada dígito; lotado = X vermelho)          */
 /* --------------------------------------------------------------------------- */
-static uint32_t cor_para_numero(uint8_t n)
-{
-    const uint32_t paleta[] = {
-        COR_AZUL, COR_VERDE, COR_LARANJA, COR_VIOLETA, COR_OURO,
-        COR_PRATA, COR_MARROM, COR_BRANCO, COR_CINZA, COR_AMARELO
-    };
-    return (n < 10) ? paleta[n] : COR_VERMELHO;
-}
+static const uint32_t paleta_ocupacao[10] = {
+    COR_AZUL, COR_VERDE, COR_LARANJA, COR_VIOLETA, COR_OURO,
+    COR_PRATA, COR_MARROM, COR_BRANCO, COR_CINZA, COR_AMARELO
+};
 
 /* --------------------------------------------------------------------------- */
 /* 7. Rotina central de desenho + feedback visual                              */
 /* --------------------------------------------------------------------------- */
-static void desenhar_tela(void)
+
+/* Marca a borda de um evento que vai mudar a tela; se já há uma pendente,
+   a mais antiga fica (é ela que mede o pior caso do desenho fundido) */
+static void latencia_marcar_evento(uint32_t ts_borda)
 {
+    uint32_t vazio = 0;
+    atomic_compare_exchange_strong(&ts_evento_us, &vazio, ts_borda | 1u);  // 0 é reservado
+}
+
+static void latencia_etapa(etapa_latencia_t etapa, uint32_t ts_borda)
+{
+    if (ts_borda) latencia_registrar(&latencias[etapa], time_us_32() - ts_borda);
+}
+
+static void matriz_quadro_exibido(void *ctx)
+{
+    latencia_etapa(LAT_MATRIZ, ts_envio_matriz);
+    ts_envio_matriz = 0;
+}
+
+/* Fim do envio DMA do OLED (contexto de IRQ) */
+static void oled_envio_concluido(void *ctx)
+{
+    latencia_etapa(LAT_OLED, ts_envio_oled);
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t)ctx, NOTIF_FLUSH_OLED, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Escritores (display_comando) se serializam numa seção crítica de poucas
+   instruções; o leitor nunca trava, só repete a cópia se uma publicação a
+   atravessou */
+static void painel_publicar(void)
+{
+    taskENTER_CRITICAL();
+    const uint32_t seq = atomic_load_explicit(&painel_seq, memory_order_relaxed);
+    atomic_store_explicit(&painel_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    const uint8_t zona = zona_ativa, pagina = pagina_tela;
+    zona_t *zp = &zonas[pagina > 0 ? pagina - 1 : zona];   // só as duas zonas exibidas: O(1)
+
+    painel.zona              = zona;
+    painel.usuarios          = zona_ocupacao(&zonas[zona]);
+    painel.capacidade        = zona_capacidade(&zonas[zona]);
+    painel.pagina            = pagina;
+    painel.usuarios_pagina   = zona_ocupacao(zp);
+    painel.capacidade_pagina = zona_capacidade(zp);
+    painel.total_resets      = total_resets;
+    painel.mostrar_msg_reset = mostrar_msg_reset;
+    painel.tela_apagada      = tela_apagada;
+
+    atomic_store_explicit(&painel_seq, seq + 2, memory_order_release);
+    taskEXIT_CRITICAL();
+}
+
+static void painel_ler(painel_state_t *retrato)
+{
+    uint32_t antes, depois;
+    do {
+        antes = atomic_load_explicit(&painel_seq, memory_order_acquire);
+        *retrato = painel;
+        atomic_thread_fence(memory_order_acquire);
+        depois = atomic_load_explicit(&painel_seq, memory_order_relaxed);
+    } while ((antes & 1u) || antes != depois);
+}
+
+static void desenhar_tela(uint32_t ts_borda)
+{
+    painel_state_t p;
+    painel_ler(&p);                                  // um retrato por quadro
+    const uint32_t usuarios_ativos = p.usuarios;
+    const uint8_t  nivel = zona_nivel(usuarios_ativos, p.capacidade);  // décimos; 10 = lotada
+
+    /* ----- Apagamento por inatividade -------------------------------------- */
+    static bool apagado = false;                     // estado já aplicado ao hardware
+    if (p.tela_apagada != apagado) {
+        apagado = p.tela_apagada;
+        if (xSemaphoreTake(mtx_oled, pdMS_TO_TICKS(100)) == pdTRUE) {
+            if (envio_oled_pendente) {
+                ulTaskNotifyTakeIndexed(NOTIF_FLUSH_OLED, pdTRUE, pdMS_TO_TICKS(100));
+                envio_oled_pendente = false;
+            }
+            ssd1306_command(&oled, apagado ? 0xAE : 0xAF);  // Display off/on; a GDDRAM é mantida
+            xSemaphoreGive(mtx_oled);
+        }
+    }
+    if (apagado) {
+        gpio_put(PINO_LED_AZUL,     false);
+        gpio_put(PINO_LED_VERDE,    false);
+        gpio_put(PINO_LED_VERMELHO, false);
+        matriz_clear();                              // Reenviado só na primeira vez
+        return;
+    }
+
     /* ----- Desenho no OLED -------------------------------------------------- */
     if (xSemaphoreTake(mtx_oled, pdMS_TO_TICKS(100)) == pdTRUE) {
         ssd1306_fill(&oled, false);
 
-        if (tela_stats_ativa) {
-            /* TELA 1 – Estatísticas */
+        if (p.pagina == 0) {
+            /* TELA 1 – Estatísticas da zona ativa */
             char buf[4][32];
-            sprintf(buf[0], "Usuarios: %d/%d", usuarios_ativos, MAX_USUARIOS);
+            snprintf(buf[0], sizeof buf[0], "%s: %lu/%lu", zonas[p.zona].nome,
+                     (unsigned long)usuarios_ativos, (unsigned long)p.capacidade);
 
-            if      (usuarios_ativos == 0)                 sprintf(buf[1], "Estado: VAZIO");
-            else if (usuarios_ativos == MAX_USUARIOS)      sprintf(buf[1], "Estado: LOTADO");
-            else if (usuarios_ativos == MAX_USUARIOS-1)    sprintf(buf[1], "Estado: ENCHENDO");
-            else                                           sprintf(buf[1], "Estado: NORMAL");
+            if      (usuarios_ativos == 0) sprintf(buf[1], "Estado: VAZIO");
+            else if (nivel == 10)          sprintf(buf[1], "Estado: LOTADO");
+            else if (nivel == 9)           sprintf(buf[1], "Estado: ENCHENDO");
+            else                           sprintf(buf[1], "Estado: NORMAL");
 
-            const char *cor_txt = (usuarios_ativos==0)          ? "AZUL"    :
-                                  (usuarios_ativos<=MAX_USUARIOS-2)? "VERDE"   :
-                                  (usuarios_ativos==MAX_USUARIOS-1)? "AMARELO" : "VERMELHO";
+            const char *cor_txt = (usuarios_ativos==0) ? "AZUL"    :
+                                  (nivel < 9)          ? "VERDE"   :
+                                  (nivel == 9)         ? "AMARELO" : "VERMELHO";
             sprintf(buf[2], "LED: %s", cor_txt);
-            sprintf(buf[3], "Resets: %ld", total_resets);
+            snprintf(buf[3], sizeof buf[3], "Resets: %lu", (unsigned long)p.total_resets);
 
+            /* Linhas em y múltiplo de 8: cada glifo vira cópia direta de colunas */
             for (uint8_t i = 0; i < 4; ++i)
-                ssd1306_draw_string(&oled, buf[i], 2, 2 + 12*i, false);
+                ssd1306_draw_string(&oled, buf[i], 2, 16*i, false);
 
-            if (mostrar_msg_reset)
-                ssd1306_draw_string(&oled, "** RESETADO! **", 15, 52, false);
-        } else {
-            /* TELA 2 – Avatares */
+            if (p.mostrar_msg_reset)
+                ssd1306_draw_string(&oled, "** RESETADO! **", 15, 56, false);
+        } else if (p.capacidade_pagina <= MAX_AVATARES) {
+            /* TELA 2 – Avatares (zona pequena: um quadrado por pessoa) */
             const uint8_t L = 12, ESP = 8, P_ROW = 5;
             const uint8_t largura_linha = P_ROW*L + (P_ROW-1)*ESP;
             const int margem_x   = (OLED_LARGURA - largura_linha)/2;
             const int y_superior = (OLED_ALTURA/4)  - L/2;
             const int y_inferior = (OLED_ALTURA*3/4) - L/2;
 
-            for (uint8_t i = 0; i < usuarios_ativos && i < MAX_USUARIOS; ++i) {
+            for (uint8_t i = 0; i < p.usuarios_pagina && i < MAX_AVATARES; ++i) {
                 int x = margem_x + (i % P_ROW)*(L+ESP);
                 int y = (i < P_ROW) ? y_superior : y_inferior;
                 ssd1306_rect(&oled, y, x, L, L, true, true);
             }
+        } else {
+            /* TELA 2 – Medidor numérico (zona grande): nome, contagem, barra e % */
+            const uint32_t permil = (uint32_t)((uint64_t)p.usuarios_pagina * 1000u / p.capacidade_pagina);
+            char buf[2][24];
+            snprintf(buf[0], sizeof buf[0], "%lu/%lu", (unsigned long)p.usuarios_pagina,
+                     (unsigned long)p.capacidade_pagina);
+            snprintf(buf[1], sizeof buf[1], "%lu.%lu%%", (unsigned long)(permil / 10),
+                     (unsigned long)(permil % 10));
+
+            ssd1306_draw_string(&oled, zonas[p.pagina - 1].nome, 2, 0, false);
+            ssd1306_draw_string(&oled, buf[0], 2, 16, false);
+            ssd1306_rect(&oled, 32, 0, OLED_LARGURA, 12, true, false);
+            const uint8_t cheio = (uint8_t)(permil * (OLED_LARGURA - 4) / 1000u);
+            if (cheio > 0) ssd1306_rect(&oled, 34, 2, cheio, 8, true, true);
+            ssd1306_draw_string(&oled, buf[1], 2, 48, false);
         }
-        ssd1306_send_data(&oled);
+        ssd1306_swap(&oled);
         xSemaphoreGive(mtx_oled);
+        latencia_etapa(LAT_RENDER, ts_borda);
+
+        /* O desenho acima sobrepõe o envio do quadro anterior; só o início do
+           próximo envio (fora do mutex, a partir do buffer da frente) espera
+           pela notificação de conclusão */
+        if (envio_oled_pendente) {
+            if (oled.dma_busy) ++renders_sobrepostos;
+            ulTaskNotifyTakeIndexed(NOTIF_FLUSH_OLED, pdTRUE, pdMS_TO_TICKS(100));
+            envio_oled_pendente = false;
+        }
+        ts_envio_oled       = ts_borda;
+        envio_oled_pendente = ssd1306_send_data_async(&oled, oled_envio_concluido, tarefa_display);
+        /* Recusado com o envio anterior ainda em curso (a espera acima venceu):
+           este quadro não chega ao OLED, só o próximo, pelas marcas acumuladas */
+        if (!envio_oled_pendente && oled.dma_busy) ++quadros_nao_enviados;
     }
 
     /* ----- Feedback LED RGB ------------------------------------------------- */
+    /* Por décimos da capacidade da zona ativa (na sala de 10, décimo = pessoa) */
     bool azul     = (usuarios_ativos == 0);
-    bool verde    = (usuarios_ativos > 0 && usuarios_ativos <= MAX_USUARIOS-2);  // 1-8: só verde
-    bool amarelo  = (usuarios_ativos == MAX_USUARIOS-1);                         // 9: verde + vermelho
-    bool vermelho_puro = (usuarios_ativos == MAX_USUARIOS);                      // 10: só vermelho
+    bool verde    = (usuarios_ativos > 0 && nivel < 9);   // até 89 %: só verde
+    bool amarelo  = (nivel == 9);                         // 90-99 %: verde + vermelho
+    bool vermelho_puro = (nivel == 10);                   // lotada: só vermelho
 
     gpio_put(PINO_LED_AZUL,     azul);
-    gpio_put(PINO_LED_VERDE,    verde || amarelo);        // Verde ligado em 1-8 e 9
-    gpio_put(PINO_LED_VERMELHO, amarelo || vermelho_puro); // Vermelho ligado em 9 e 10
+    gpio_put(PINO_LED_VERDE,    verde || amarelo);
+    gpio_put(PINO_LED_VERMELHO, amarelo || vermelho_puro);
 
     /* ----- Feedback matriz 5×5 --------------------------------------------- */
-    if (usuarios_ativos == MAX_USUARIOS)
-        matriz_draw_pattern(PAD_X, COR_VERMELHO);          // lotado
-    else
-        matriz_draw_number(usuarios_ativos, cor_para_numero(usuarios_ativos));
+    /* Décimo da zona ativa (na sala de 10, o próprio número); quadro pré-calculado,
+       sem envio se o nível não mudou (ex.: troca de tela) */
+    ts_envio_matriz = ts_borda;                            // lido no alarme do latch
+    if (!matriz_draw_occupancy(nivel))                     // 10 = lotado (X)
+        ts_envio_matriz = 0;                               // mesmo quadro: nada a medir
+}
+
+/* Canal de comandos do display: cada comando é um bit de notificação da
+   task_display, então pedidos que chegam antes do próximo desenho se fundem
+   em um só. Comandos que mudam estado aplicam a mudança aqui, no produtor
+   (cada flag tem um único escritor), e publicam o retrato antes de acordar
+   o display; por isso nunca se perdem na fusão. */
+static void display_comando(comando_display_t cmd)
+{
+    switch (cmd) {
+        case CMD_MOSTRAR_MSG_RESET: mostrar_msg_reset = true;              break;
+        case CMD_OCULTAR_MSG_RESET: mostrar_msg_reset = false;             break;
+        case CMD_ALTERNAR_TELA:     pagina_tela       = (pagina_tela + 1) % (NUM_ZONAS + 1); break;
+        case CMD_APAGAR_TELA:       tela_apagada      = true;              break;
+        case CMD_ACENDER_TELA:      tela_apagada      = false;             break;
+        case CMD_ATUALIZAR_TELA:                                           break;
+    }
+    painel_publicar();
+
+    atomic_fetch_add_explicit(&cmds_display, 1, memory_order_relaxed);
+    if (tarefa_display == NULL) {
+        atomic_fetch_add_explicit(&cmds_descartados, 1, memory_order_relaxed);
+        return;
+    }
+
+    uint32_t pendentes = 0;
+    xTaskNotifyAndQueryIndexed(tarefa_display, NOTIF_COMANDOS, 1u << cmd, eSetBits, &pendentes);
+    // Fundido só se o próprio bit já estava pendente; outro bit não absorve este comando
+    if (pendentes & (1u << cmd)) atomic_fetch_add_explicit(&cmds_fundidos, 1, memory_order_relaxed);
 }
 
 /* --------------------------------------------------------------------------- */
-/* 8. Interrupção do joystick (RESET)                                          */
+/* 8. Interrupções de GPIO (botões A/B e joystick)                            */
 /* --------------------------------------------------------------------------- */
 static volatile uint32_t ultimo_irq_ms = 0;
 static const uint32_t   debounce_ms   = 400;
 
+/* Botões A/B: eventos entregues à task_botoes como bits de notificação.
+   Apertos do mesmo botão enquanto a task está ocupada (beep de 100 ms) se
+   fundem no mesmo bit e contam uma vez */
+#define EVT_ENTRADA           (1u << 0)
+#define EVT_SAIDA             (1u << 1)
+#define DEBOUNCE_BOTAO_US     50000        // 50 ms
+
+typedef struct {
+    uint     pino;
+    uint32_t evento;
+    bool     pressionado;
+    uint32_t ultima_borda_us;              // última borda aceita (aperto ou soltura)
+    volatile uint32_t ts_aperto_us;        // instante do último aperto entregue
+} botao_t;
+
+static botao_t botoes[] = {
+    { PINO_BTN_ENTRADA, EVT_ENTRADA, false, 0, 0 },
+    { PINO_BTN_SAIDA,   EVT_SAIDA,   false, 0, 0 },
+};
+
+static TaskHandle_t tarefa_botoes;
+static volatile uint32_t ts_reset_us = 0;  // instante da última borda aceita do joystick
+
 static void irq_joystick(uint gpio, uint32_t eventos)
 {
     uint32_t agora = to_ms_since_boot(get_absolute_time());
     if (agora - ultimo_irq_ms < debounce_ms) return;
     ultimo_irq_ms = agora;
+    ts_reset_us   = time_us_32();
 
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     xSemaphoreGiveFromISR(sem_reset_irq, &xHigherPriorityTaskWoken);
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
+static int64_t botao_reamostrar(alarm_id_t id, void *dados);
+
+/* Aplica o nível lido do pino (pull-up: apertado = baixo). Cada mudança abre
+   uma janela de DEBOUNCE_BOTAO_US e agenda uma nova leitura no fim dela; um
+   aperto novo vai à task_botoes */
+static void botao_aplicar(botao_t *b, bool apertado, uint32_t agora)
+{
+    if (apertado == b->pressionado) return;
+    b->pressionado     = apertado;
+    b->ultima_borda_us = agora;
+    add_alarm_in_us(DEBOUNCE_BOTAO_US, botao_reamostrar, b, true);
+    if (!apertado) return;
+
+    b->ts_aperto_us = agora;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xTaskNotifyFromISR(tarefa_botoes, b->evento, eSetBits, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Fim da janela: um toque mais curto que ela teve a soltura descartada como
+   repique; sem reler o pino, o próximo aperto seria engolido */
+static int64_t botao_reamostrar(alarm_id_t id, void *dados)
+{
+    botao_t *b = dados;
+    botao_aplicar(b, !gpio_get(b->pino), time_us_32());
+    return 0;
+}
+
+/* Debounce por carimbo de tempo: bordas a menos de DEBOUNCE_BOTAO_US da última
+   mudança aceita são repiques. Fora da janela vale o nível do pino, não o
+   tipo da borda, então o estado acompanha o botão real. */
+static void irq_botao(botao_t *b, uint32_t eventos)
+{
+    (void)eventos;
+    uint32_t agora = time_us_32();
+    if (agora - b->ultima_borda_us < DEBOUNCE_BOTAO_US) return;
+    botao_aplicar(b, !gpio_get(b->pino), agora);
+}
+
+/* Callback único de GPIO do SDK: despacha pelo pino */
+static void irq_gpio(uint gpio, uint32_t eventos)
+{
+    switch (gpio) {
+        case PINO_JOYSTICK_RESET: irq_joystick(gpio, eventos); break;
+        case PINO_BTN_ENTRADA:    irq_botao(&botoes[0], eventos); break;
+        case PINO_BTN_SAIDA:      irq_botao(&botoes[1], eventos); break;
+    }
+}
+
 /* --------------------------------------------------------------------------- */
 /* 9. Tasks FreeRTOS                                                          */
 /* --------------------------------------------------------------------------- */
 
-/* Botão A – Entrada --------------------------------------------------------- */
-static void task_entrada(void *arg)
+/* Entrada do usuário: adia o apagamento e, com o painel já apagado, acorda a
+   task_alternar_tela (única escritora de tela_apagada) para reacendê-lo */
+static void registrar_atividade(void)
 {
-    bool estado_ant = true;
+    ultima_atividade = xTaskGetTickCount();
+    if (tela_apagada && tarefa_alternar != NULL) xTaskNotifyGive(tarefa_alternar);
+}
 
-    while (1) {
-        bool estado_atual = gpio_get(PINO_BTN_ENTRADA);
-
-        if (estado_ant && !estado_atual) {
-            vTaskDelay(pdMS_TO_TICKS(50));                 // debounce
-
-            if (!gpio_get(PINO_BTN_ENTRADA)) {
-                if (xSemaphoreTake(sem_vagas, 0) == pdTRUE) {
-                    xSemaphoreTake(mtx_usuarios, portMAX_DELAY);
-                    ++usuarios_ativos;
-                    xSemaphoreGive(mtx_usuarios);
-
-                    comando_display_t cmd = CMD_ATUALIZAR_TELA;
-                    xQueueSendToBack(fila_display, &cmd, 0);
-                } else {
-                    /* Beep curto – sistema lotado */
-                    buzzer_on();
-                    vTaskDelay(pdMS_TO_TICKS(100));
-                    buzzer_off();
-                }
+/* Núcleo da admissão, comum aos botões, ao joystick e ao gerador de carga.
+   'etapa' é o histograma de latência do chamador, que é o seu único escritor */
+static bool admitir_entrada(uint8_t zona, etapa_latencia_t etapa, uint32_t ts_borda)
+{
+    const bool admitido = zona_entrar(&zonas[zona]);
+    latencia_etapa(etapa, ts_borda);
+    eventos_registrar(admitido ? LOG_ENTRADA : LOG_RECUSA, zona, zona_ocupacao(&zonas[zona]));
 
-                while (!gpio_get(PINO_BTN_ENTRADA))
-                    vTaskDelay(pdMS_TO_TICKS(10));
-            }
-        }
-        estado_ant = estado_atual;
-        vTaskDelay(pdMS_TO_TICKS(10));
+    if (admitido) {
+        latencia_marcar_evento(ts_borda);
+        display_comando(CMD_ATUALIZAR_TELA);
     }
+    return admitido;
 }
 
-/* Botão B – Saída ----------------------------------------------------------- */
-static void task_saida(void *arg)
+static bool admitir_saida(uint8_t zona, etapa_latencia_t etapa, uint32_t ts_borda)
 {
-    bool estado_ant = true;
-
-    while (1) {
-        bool estado_atual = gpio_get(PINO_BTN_SAIDA);
-
-        if (estado_ant && !estado_atual) {
-            vTaskDelay(pdMS_TO_TICKS(50));
+    const bool saiu = zona_sair(&zonas[zona]);
+    latencia_etapa(etapa, ts_borda);
+    if (saiu) eventos_registrar(LOG_SAIDA, zona, zona_ocupacao(&zonas[zona]));
+    latencia_marcar_evento(ts_borda);
+    display_comando(CMD_ATUALIZAR_TELA);
+    return saiu;
+}
 
-            if (!gpio_get(PINO_BTN_SAIDA)) {
-                xSemaphoreTake(mtx_usuarios, portMAX_DELAY);
+/* Zera a zona e publica zero e contagem no mesmo retrato; o aviso na tela
+   fica com o chamador */
+static void zerar_zona(uint8_t zona, etapa_latencia_t etapa, uint32_t ts_borda)
+{
+    eventos_registrar(LOG_RESET, zona, zona_zerar(&zonas[zona]));
+    atomic_fetch_add(&total_resets, 1);
+    painel_publicar();
+    latencia_etapa(etapa, ts_borda);
+    latencia_marcar_evento(ts_borda);
+}
 
-                if (usuarios_ativos > 0) {
-                    --usuarios_ativos;
-                    xSemaphoreGive(sem_vagas);
-                }
+/* Botão A – Entrada (na zona ativa) ----------------------------------------- */
+static void processar_entrada(void)
+{
+    if (!admitir_entrada(zona_ativa, LAT_ENTRADA, botoes[0].ts_aperto_us)) {
+        /* Beep curto – sistema lotado */
+        buzzer_on();
+        vTaskDelay(pdMS_TO_TICKS(100));
+        buzzer_off();
+    }
+}
 
-                xSemaphoreGive(mtx_usuarios);
+/* Botão B – Saída (na zona ativa) ------------------------------------------- */
+static void processar_saida(void)
+{
+    admitir_saida(zona_ativa, LAT_ENTRADA, botoes[1].ts_aperto_us);
+}
 
-                comando_display_t cmd = CMD_ATUALIZAR_TELA;
-                xQueueSendToBack(fila_display, &cmd, 0);
+/* Botões A/B – bloqueada até a IRQ notificar um aperto ----------------------- */
+static void task_botoes(void *arg)
+{
+    uint32_t eventos;
 
-                while (!gpio_get(PINO_BTN_SAIDA))
-                    vTaskDelay(pdMS_TO_TICKS(10));
-            }
+    while (1) {
+        if (xTaskNotifyWait(0, UINT32_MAX, &eventos, portMAX_DELAY) == pdTRUE) {
+            registrar_atividade();
+            if (eventos & EVT_ENTRADA) processar_entrada();
+            if (eventos & EVT_SAIDA)   processar_saida();
         }
-        estado_ant = estado_atual;
-        vTaskDelay(pdMS_TO_TICKS(10));
     }
 }
 
-/* RESET via joystick -------------------------------------------------------- */
+/* RESET via joystick (zera a zona ativa) ----------------------------------- */
 static void task_reset(void *arg)
 {
-    comando_display_t cmd_show  = CMD_MOSTRAR_MSG_RESET;
-    comando_display_t cmd_clear = CMD_OCULTAR_MSG_RESET;
-
     while (1) {
         if (xSemaphoreTake(sem_reset_irq, portMAX_DELAY) == pdTRUE) {
-            xSemaphoreTake(mtx_usuarios, portMAX_DELAY);
-
-            for (uint8_t i = 0; i < usuarios_ativos; ++i) xSemaphoreGive(sem_vagas);
-            usuarios_ativos = 0;
-            ++total_resets;
-
-            xSemaphoreGive(mtx_usuarios);
+            const uint32_t ts_borda = ts_reset_us;
+            registrar_atividade();
+            zerar_zona(zona_ativa, LAT_RESET, ts_borda);  // a tela só muda com a mensagem, após o beep
 
             /* Beep duplo */
             for (uint8_t i = 0; i < 2; ++i) {
@@ -266,40 +615,481 @@ static void task_reset(void *arg)
                 vTaskDelay(pdMS_TO_TICKS(100));
             }
 
-            xQueueSendToBack(fila_display, &cmd_show, 0);
+            display_comando(CMD_MOSTRAR_MSG_RESET);
             vTaskDelay(pdMS_TO_TICKS(2000));
-            xQueueSendToBack(fila_display, &cmd_clear, 0);
+            display_comando(CMD_OCULTAR_MSG_RESET);
         }
     }
 }
 
-/* Alternar tela ------------------------------------------------------------- */
+/* Alternar tela e apagamento por inatividade -------------------------------- */
 static void task_alternar_tela(void *arg)
 {
-    comando_display_t cmd = CMD_ALTERNAR_TELA;
     while (1) {
-        vTaskDelay(pdMS_TO_TICKS(2000));
-        xQueueSendToBack(fila_display, &cmd, 0);
+        /* Aceso: alterna a cada 2 s. Apagado: espera sem timeout até uma
+           entrada notificar, sem acordar o núcleo no tickless idle */
+        const TickType_t espera  = tela_apagada ? portMAX_DELAY : pdMS_TO_TICKS(2000);
+        const bool       acordada = ulTaskNotifyTake(pdTRUE, espera) > 0;
+        const TickType_t vista    = ultima_atividade;
+        const bool       inativo  = INATIVIDADE_APAGAR_MS > 0 &&
+            (xTaskGetTickCount() - vista) >= pdMS_TO_TICKS(INATIVIDADE_APAGAR_MS);
+
+        if (tela_apagada) {
+            if (!inativo) display_comando(CMD_ACENDER_TELA);
+        } else if (inativo) {
+            display_comando(CMD_APAGAR_TELA);
+            /* Uma entrada entre a leitura acima e o apagamento ainda viu a tela
+               acesa e não notificou: sem reler, a espera sem timeout a perderia */
+            if (ultima_atividade != vista) {
+                display_comando(CMD_ACENDER_TELA);
+                continue;
+            }
+            uint32_t permil = energia_residencia_permil();
+            printf("Painel apagado: %lu.%lu%% do tempo em sono (%lu sonos)\n",
+                   (unsigned long)(permil / 10), (unsigned long)(permil % 10),
+                   (unsigned long)energia_sonos());
+        } else if (!acordada) {
+            display_comando(CMD_ALTERNAR_TELA);
+        }
     }
 }
 
-/* Consumidora da fila ------------------------------------------------------- */
-static void task_display(void *arg)
+/* Gerador de carga ------------------------------------------------------------
+   Entradas, saídas e resets injetados pelo stdio (comando 'g') a taxas fixas
+   na zona ativa, pelo mesmo núcleo de admissão dos botões e do joystick, sem
+   beep nem aviso de reset. A cada tick injeta os eventos devidos até ali
+   (no máximo CARGA_LOTE_MAX de cada tipo; o resto conta como atraso) e, no
+   fim, relata aceitos, recusados, comandos do display fundidos/descartados
+   e quadros por segundo. Um novo 'g' durante o teste encerra o atual
+   (relatório marcado "interrompido") e já começa o novo, se tiver duração */
+typedef struct {
+    uint32_t por_s[3];   // entradas, saídas e resets por segundo
+    uint32_t segundos;   // 0 = nenhum teste (ou interrompe o atual)
+} carga_cfg_t;
+
+static carga_cfg_t carga_cfg;   // escrito pela task_telemetria antes de notificar
+
+/* "g<entradas/s> <saídas/s> <resets/s> <segundos>"; qualquer não dígito separa */
+static void carga_comando(const char *args)
+{
+    uint32_t v[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4 && *args; ++i) {
+        while (*args && (*args < '0' || *args > '9')) ++args;
+        char *fim;
+        v[i] = (uint32_t)strtoul(args, &fim, 10);
+        args = fim;
+    }
+    carga_cfg = (carga_cfg_t){ { v[0], v[1], v[2] }, v[3] > CARGA_MAX_S ? CARGA_MAX_S : v[3] };
+    if (carga_cfg.segundos > 0)
+        printf("Carga: %lu entradas/s, %lu saidas/s, %lu resets/s por %lu s na zona %s\n",
+               (unsigned long)v[0], (unsigned long)v[1], (unsigned long)v[2],
+               (unsigned long)carga_cfg.segundos, zonas[zona_ativa].nome);
+    xTaskNotifyGive(tarefa_carga);   // com o teste em curso, encerra e recomeça com a nova configuração
+}
+
+static void task_carga(void *arg)
+{
+    bool pendente = false;   // notificação consumida pelo teste anterior
+    while (1) {
+        if (!pendente) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        pendente = false;
+        const carga_cfg_t cfg  = carga_cfg;
+        const uint8_t     zona = zona_ativa;
+        if (cfg.segundos == 0) continue;
+
+        const uint32_t fundidos0    = cmds_fundidos;
+        const uint32_t nao_env0     = quadros_nao_enviados;
+        const uint32_t comandos0    = cmds_display;
+        const uint32_t quadros0     = quadros_desenhados;
+        eventos_stats_t ev0;
+        eventos_estatisticas(&ev0);
+
+        uint32_t devidos_ant[3] = { 0, 0, 0 }, injetados[3] = { 0, 0, 0 }, atrasados = 0;
+        uint32_t aceitos = 0, recusados = 0, saidas_efetivas = 0;
+        const uint32_t inicio   = time_us_32();
+        const uint32_t duracao  = cfg.segundos * 1000000u;
+        uint32_t       decorrido = 0;
+
+        while (decorrido < duracao) {
+            if (ulTaskNotifyTake(pdTRUE, 0) != 0) { pendente = true; break; }
+            decorrido = time_us_32() - inicio;
+            if (decorrido > duracao) decorrido = duracao;
+
+            for (int t = 0; t < 3; ++t) {
+                const uint32_t devidos = (uint32_t)((uint64_t)cfg.por_s[t] * decorrido / 1000000u);
+                uint32_t lote = devidos - devidos_ant[t];
+                if (lote > CARGA_LOTE_MAX) { atrasados += lote - CARGA_LOTE_MAX; lote = CARGA_LOTE_MAX; }
+                for (uint32_t i = 0; i < lote; ++i) {
+                    const uint32_t ts = time_us_32();
+                    switch (t) {
+                        case 0: if (admitir_entrada(zona, LAT_CARGA, ts)) ++aceitos; else ++recusados; break;
+                        case 1: if (admitir_saida(zona, LAT_CARGA, ts)) ++saidas_efetivas; break;
+                        case 2: zerar_zona(zona, LAT_CARGA, ts); display_comando(CMD_ATUALIZAR_TELA); break;
+                    }
+                }
+                injetados[t]  += lote;
+                devidos_ant[t] = devidos;   // o atraso não é reposto depois
+            }
+            registrar_atividade();
+            vTaskDelay(1);
+        }
+
+        eventos_stats_t ev;
+        eventos_estatisticas(&ev);
+        const uint32_t ms      = (time_us_32() - inicio) / 1000u;
+        const uint32_t quadros = quadros_desenhados - quadros0;
+        const uint32_t qps_10  = ms ? (uint32_t)((uint64_t)quadros * 10000u / ms) : 0;
+        printf("Carga: %lu ms%s; entradas %lu aceitas, %lu recusadas; saidas %lu (%lu efetivas); %lu resets; %lu atrasados\n",
+               (unsigned long)ms, pendente ? " (interrompido)" : "", (unsigned long)aceitos, (unsigned long)recusados,
+               (unsigned long)injetados[1], (unsigned long)saidas_efetivas,
+               (unsigned long)injetados[2], (unsigned long)atrasados);
+        printf("Carga: display %lu comandos, %lu fundidos; %lu quadros (%lu.%lu q/s), %lu nao enviados (OLED ocupado); %lu eventos perdidos no log\n",
+               (unsigned long)(cmds_display - comandos0), (unsigned long)(cmds_fundidos - fundidos0),
+               (unsigned long)quadros,
+               (unsigned long)(qps_10 / 10), (unsigned long)(qps_10 % 10),
+               (unsigned long)(quadros_nao_enviados - nao_env0),
+               (unsigned long)(ev.descartados - ev0.descartados));
+    }
+}
+
+/* Telemetria: CPU por task na janela, pilha e canal de comandos ------------- */
+static TaskStatus_t tasks_telemetria[TELEMETRIA_MAX_TASKS];
+static uint16_t     cpu_permil[TELEMETRIA_MAX_TASKS];   // paralelo a tasks_telemetria
+
+/* Estado das tasks e uso de CPU desde a coleta anterior (texto ou binária) */
+static UBaseType_t telemetria_coletar(void)
+{
+    static uint32_t runtime_anterior[TELEMETRIA_MAX_TASKS];
+    static uint32_t total_anterior = 0;
+
+    uint32_t total;
+    UBaseType_t n = uxTaskGetSystemState(tasks_telemetria, TELEMETRIA_MAX_TASKS, &total);
+    const uint32_t janela = (total - total_anterior) * configNUM_CORES;  // µs de CPU disponíveis
+    total_anterior = total;
+
+    for (UBaseType_t i = 0; i < n; ++i) {
+        uint32_t *anterior = &runtime_anterior[tasks_telemetria[i].xTaskNumber & (TELEMETRIA_MAX_TASKS-1)];
+        uint32_t  uso      = tasks_telemetria[i].ulRunTimeCounter - *anterior;
+        *anterior = tasks_telemetria[i].ulRunTimeCounter;
+        cpu_permil[i] = janela ? (uint16_t)((uint64_t)uso * 1000u / janela) : 0;
+    }
+    return n;
+}
+
+static void telemetria_relatorio(void)
+{
+    UBaseType_t n = telemetria_coletar();
+
+    printf("--- Telemetria ---\n");
+    printf("%-13s %6s %12s\n", "Task", "CPU%", "Pilha livre");
+    for (UBaseType_t i = 0; i < n; ++i) {
+        printf("%-13s %4lu.%lu %10lu B\n", tasks_telemetria[i].pcTaskName,
+               (unsigned long)(cpu_permil[i] / 10), (unsigned long)(cpu_permil[i] % 10),
+               (unsigned long)(tasks_telemetria[i].usStackHighWaterMark * sizeof(StackType_t)));
+    }
+#if configSUPPORT_DYNAMIC_ALLOCATION
+    printf("Heap: %u B livres, minimo %u B\n",
+           (unsigned)xPortGetFreeHeapSize(), (unsigned)xPortGetMinimumEverFreeHeapSize());
+#endif
+    const uint32_t flush_fim = oled.flush_completed;  // Antes dos iniciados, como no quadro binário
+    const uint32_t flush_ini = oled.flush_started;
+    printf("Comandos: %lu recebidos, %lu fundidos, %lu antes da task; %lu quadros, %lu sobrepostos\n",
+           (unsigned long)cmds_display, (unsigned long)cmds_fundidos, (unsigned long)cmds_descartados,
+           (unsigned long)quadros_desenhados, (unsigned long)renders_sobrepostos);
+    printf("Envios OLED: %lu iniciados, %lu concluidos, %lu em curso, %lu cancelados; %lu quadros nao enviados\n",
+           (unsigned long)flush_ini, (unsigned long)flush_fim,
+           (unsigned long)(flush_ini - flush_fim), (unsigned long)oled.flush_aborted,
+           (unsigned long)quadros_nao_enviados);
+
+    eventos_stats_t ev;
+    eventos_estatisticas(&ev);
+    printf("Eventos: %lu registrados, %lu descartados; %lu setores gravados (seq %lu), %lu na RAM\n",
+           (unsigned long)ev.registrados, (unsigned long)ev.descartados, (unsigned long)ev.setores,
+           (unsigned long)ev.seq, (unsigned long)ev.na_pagina);
+
+    contadores_stats_t ct;
+    contadores_estatisticas(&ct);
+    printf("Contadores: setor %lu (geracao %lu, %lu livres); boot %lu us / %lu registros; %lu paginas, %lu compactacoes\n",
+           (unsigned long)ct.setor, (unsigned long)ct.geracao, (unsigned long)ct.livres,
+           (unsigned long)ct.carga_us, (unsigned long)ct.registros_lidos,
+           (unsigned long)ct.paginas, (unsigned long)ct.compactacoes);
+
+    tbin_stats_t tb;
+    tbin_estatisticas(&tb);
+    printf("Binario: %lu quadros, %lu bytes\n", (unsigned long)tb.quadros, (unsigned long)tb.bytes);
+
+    printf("%-6s %11s %8s %8s %8s %6s\n", "Zona", "Ocupacao", "Entradas", "Saidas", "Recusas", "Resets");
+    for (int i = 0; i < NUM_ZONAS; ++i) {
+        zona_t *z = &zonas[i];
+        printf("%c%-5s %5lu/%-5lu %8lu %8lu %8lu %6lu\n", i == zona_ativa ? '*' : ' ', z->nome,
+               (unsigned long)zona_ocupacao(z), (unsigned long)zona_capacidade(z),
+               (unsigned long)z->entradas, (unsigned long)z->saidas,
+               (unsigned long)z->recusas, (unsigned long)z->resets);
+    }
+}
+
+static void latencia_relatorio(void)
+{
+    printf("--- Latencia desde a borda ---\n");
+    for (int i = 0; i < LAT_ETAPAS; ++i)
+        latencia_imprimir(nomes_latencia[i], &latencias[i]);
+}
+
+/* Telemetria binária (tecla 'b'): quadros COBS montados sem printf -------- */
+static inline uint16_t saturar16(uint32_t v) { return v > 0xFFFFu ? 0xFFFFu : (uint16_t)v; }
+
+/* Um quadro por zona que mudou desde a última amostra (ou todas) */
+static void telemetria_bin_ocupacao(bool todas)
+{
+    static tbin_ocupacao_t ultima[NUM_ZONAS];
+
+    for (int i = 0; i < NUM_ZONAS; ++i) {
+        zona_t *z = &zonas[i];
+        tbin_ocupacao_t q = {
+            .zona       = (uint8_t)i,
+            .ocupacao   = saturar16(zona_ocupacao(z)),
+            .capacidade = saturar16(zona_capacidade(z)),
+            .entradas   = z->entradas,
+            .saidas     = z->saidas,
+            .recusas    = z->recusas,
+        };
+        if (!todas && q.ocupacao == ultima[i].ocupacao && q.entradas == ultima[i].entradas &&
+            q.saidas == ultima[i].saidas && q.recusas == ultima[i].recusas)
+            continue;
+        q.ts_ms = xTaskGetTickCount();
+        ultima[i] = q;
+        tbin_enviar(TBIN_OCUPACAO, &q, sizeof q);
+    }
+}
+
+/* Tasks (CPU na janela, pilha), resumo de cada etapa de latência e display */
+static void telemetria_bin_periodico(void)
+{
+    UBaseType_t n = telemetria_coletar();
+    const uint32_t agora = xTaskGetTickCount();
+
+    for (UBaseType_t i = 0; i < n; ++i) {
+        tbin_task_t q = {
+            .ts_ms       = agora,
+            .numero      = (uint8_t)tasks_telemetria[i].xTaskNumber,
+            .prioridade  = (uint8_t)tasks_telemetria[i].uxCurrentPriority,
+            .cpu_permil  = cpu_permil[i],
+            .pilha_livre = saturar16(tasks_telemetria[i].usStackHighWaterMark * sizeof(StackType_t)),
+        };
+        const char *nome = tasks_telemetria[i].pcTaskName;
+        for (size_t k = 0; k < sizeof q.nome && nome[k]; ++k) q.nome[k] = nome[k];
+        tbin_enviar(TBIN_TASK, &q, sizeof q);
+    }
+    for (int i = 0; i < LAT_ETAPAS; ++i) {
+        const latencia_hist_t *h = &latencias[i];
+        tbin_latencia_t q = {
+            .ts_ms    = agora,
+            .etapa    = (uint8_t)i,
+            .amostras = h->amostras,
+            .p50_us   = latencia_percentil(h, 500),
+            .p99_us   = latencia_percentil(h, 990),
+            .max_us   = h->max_us,
+        };
+        tbin_enviar(TBIN_LATENCIA, &q, sizeof q);
+    }
+    // Concluídos lidos antes dos iniciados: o "em curso" nunca fica negativo
+    const uint32_t flush_fim = oled.flush_completed;
+    tbin_display_t d = {
+        .ts_ms            = agora,
+        .comandos         = cmds_display,
+        .fundidos         = cmds_fundidos,
+        .quadros          = quadros_desenhados,
+        .sobrepostos      = renders_sobrepostos,
+        .flush_iniciados  = oled.flush_started,
+        .flush_concluidos = flush_fim,
+        .flush_cancelados = oled.flush_aborted,
+    };
+    tbin_enviar(TBIN_DISPLAY, &d, sizeof d);
+}
+
+/* Chegaram bytes no stdio (IRQ do USB/UART): acorda a telemetria */
+static void stdio_chegou(void *ctx)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR((TaskHandle_t)ctx, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Relatório periódico + comandos de uma letra pelo stdio:
+   't' telemetria, 'l' latências, 'z' zera os histogramas,
+   'b' liga/desliga a telemetria binária (host/ferramentas/telemetria_csv.py),
+   'g<e/s> <s/s> <r/s> <s>' + Enter roda o gerador de carga ('g' + Enter interrompe),
+   '1'-'9' escolhe a zona ativa (botões, joystick, LEDs e matriz).
+   No modo binário a ocupação é amostrada a cada TELEMETRIA_BIN_MS e só as
+   zonas que mudaram geram quadro; tasks e latências saem a cada TELEMETRIA_MS
+   no lugar do relatório em texto */
+static void task_telemetria(void *arg)
 {
-    comando_display_t cmd;
+    bool       binaria = false;
+    TickType_t ultimo_periodico = xTaskGetTickCount();
+    char       linha_carga[32];
+    int        n_carga = -1;          // >= 0: lendo os argumentos do 'g' até o fim da linha
+
+    stdio_set_chars_available_callback(stdio_chegou, xTaskGetCurrentTaskHandle());
 
     while (1) {
-        if (xQueueReceive(fila_display, &cmd, portMAX_DELAY) == pdPASS) {
-            switch (cmd) {
-                case CMD_ATUALIZAR_TELA:        desenhar_tela(); break;
-                case CMD_MOSTRAR_MSG_RESET:     mostrar_msg_reset = true;  desenhar_tela(); break;
-                case CMD_OCULTAR_MSG_RESET:     mostrar_msg_reset = false; desenhar_tela(); break;
-                case CMD_ALTERNAR_TELA:         tela_stats_ativa = !tela_stats_ativa;       desenhar_tela(); break;
+        const TickType_t espera = binaria          ? pdMS_TO_TICKS(TELEMETRIA_BIN_MS)
+                                : TELEMETRIA_MS > 0 ? pdMS_TO_TICKS(TELEMETRIA_MS) : portMAX_DELAY;
+        const bool chegou = ulTaskNotifyTake(pdTRUE, espera) != 0;
+
+        if (binaria) {
+            telemetria_bin_ocupacao(false);
+            if (TELEMETRIA_MS > 0 &&
+                xTaskGetTickCount() - ultimo_periodico >= pdMS_TO_TICKS(TELEMETRIA_MS)) {
+                ultimo_periodico = xTaskGetTickCount();
+                telemetria_bin_periodico();
+            }
+        } else if (!chegou) {
+            telemetria_relatorio();
+        }
+        if (!chegou) continue;
+
+        int c;
+        while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+            if (n_carga >= 0) {
+                if (c == '\n' || c == '\r') {
+                    linha_carga[n_carga] = '\0';
+                    n_carga = -1;
+                    carga_comando(linha_carga);
+                } else if (n_carga < (int)sizeof linha_carga - 1) {
+                    linha_carga[n_carga++] = (char)c;
+                }
+                continue;
+            }
+            switch (c) {
+                case 't':
+                    if (binaria) { telemetria_bin_ocupacao(true); telemetria_bin_periodico(); }
+                    else         telemetria_relatorio();
+                    break;
+                case 'l': latencia_relatorio();   break;
+                case 'g': n_carga = 0;            break;
+                case 'z':
+                    /* OLED e Matriz são escritos em IRQ (núcleo 0, o mesmo desta task):
+                       um registro no meio do memset deixaria amostras sem contagem */
+                    for (int i = 0; i < LAT_ETAPAS; ++i) {
+                        taskENTER_CRITICAL();
+                        latencia_zerar(&latencias[i]);
+                        taskEXIT_CRITICAL();
+                    }
+                    printf("Latencias zeradas\n");
+                    break;
+                case 'b':
+                    binaria = !binaria;
+                    printf("Telemetria binaria %s\n", binaria ? "ligada" : "desligada");
+                    if (binaria) {
+                        // Retrato completo para o host partir de um estado conhecido
+                        ultimo_periodico = xTaskGetTickCount();
+                        telemetria_bin_ocupacao(true);
+                        telemetria_bin_periodico();
+                    }
+                    break;
+                default:
+                    if (c >= '1' && c < '1' + NUM_ZONAS) {
+                        zona_ativa = (uint8_t)(c - '1');
+                        printf("Zona ativa: %s\n", zonas[zona_ativa].nome);
+                        display_comando(CMD_ATUALIZAR_TELA);
+                    }
+                    break;
             }
         }
     }
 }
 
+/* Copia os valores vivos para os contadores; só os alterados vão à flash */
+static void persistir_contadores(void)
+{
+    contadores_definir(CONT_RESETS, total_resets);
+    for (int i = 0; i < NUM_ZONAS; ++i)
+        contadores_definir(CONT_OCUPACAO(i), zona_ocupacao(&zonas[i]));
+    contadores_persistir();
+}
+
+/* Único escritor da flash, sempre fora do caminho da entrada. Um setor cheio
+   do log custa um apagamento + programação (~50 ms com as interrupções
+   paradas) a cada EVENTOS_POR_SETOR eventos; os contadores, uma página
+   (~1 ms) por período com mudança e um apagamento só ao compactar -------- */
+static void task_flash(void *arg)
+{
+    TickType_t ultima_gravacao = xTaskGetTickCount();
+
+    while (1) {
+        eventos_drenar();
+        if (xTaskGetTickCount() - ultima_gravacao >= pdMS_TO_TICKS(CONTADORES_PERIODO_MS)) {
+            ultima_gravacao = xTaskGetTickCount();
+            persistir_contadores();
+        }
+        vTaskDelay(pdMS_TO_TICKS(EVENTOS_DRENO_MS));
+    }
+}
+
+/* Consumidora dos comandos -------------------------------------------------- */
+static void task_display(void *arg)
+{
+    uint32_t pendentes;
+
+    /* UI inicial */
+    desenhar_tela(0);
+
+    while (1) {
+        /* Todos os comandos acumulados desde o último desenho → um único desenho */
+        if (xTaskNotifyWaitIndexed(NOTIF_COMANDOS, 0, UINT32_MAX, &pendentes, portMAX_DELAY) == pdTRUE) {
+            const uint32_t ts_borda = atomic_exchange(&ts_evento_us, 0);
+            latencia_etapa(LAT_DESPACHO, ts_borda);
+            desenhar_tela(ts_borda);
+            ++quadros_desenhados;
+        }
+    }
+}
+
+#if PAINEL_BENCH
+/* Benchmark -------------------------------------------------------------------
+   Primitivas do SSD1306 e da matriz, depois o desenhar_tela completo nas
+   telas de estatísticas, avatares e medidor: com o retrato parado (nada a
+   enviar) e com a contagem da zona alternando ±1 (o quadro seguinte espera
+   o envio por DMA do anterior) */
+static void bench_desenhar(void *ctx, uint32_t i)
+{
+    if (ctx != NULL) {                               // ctx = zona: alterna a contagem
+        if (i & 1u) zona_sair(ctx); else zona_entrar(ctx);
+        painel_publicar();
+    }
+    desenhar_tela(0);
+}
+
+static void bench_pagina(uint8_t pagina, const char *fixa, const char *alternando)
+{
+    pagina_tela = pagina;
+    painel_publicar();
+    desenhar_tela(0);                                // quadro de referência
+
+    zona_t *z = &zonas[pagina > 0 ? pagina - 1 : zona_ativa];
+    bench_executar(fixa,       bench_desenhar, NULL, 500, &oled.bytes_sent);
+    bench_executar(alternando, bench_desenhar, z,    500, &oled.bytes_sent);
+}
+
+static void task_bench(void *arg)
+{
+    tarefa_display = xTaskGetCurrentTaskHandle();    // recebe o fim do envio do OLED
+
+    bench_cabecalho();
+    bench_primitivas(&oled);
+
+    ssd1306_invalidate(&oled);
+    for (int i = 0; i < 3; ++i) zona_entrar(&zonas[0]);
+    for (int i = 0; i < 123; ++i) zona_entrar(&zonas[NUM_ZONAS - 1]);
+    bench_pagina(0,         "desenhar_tela stats fixa",    "desenhar_tela stats 3<->4");
+    bench_pagina(1,         "desenhar_tela avatares fixa", "desenhar_tela avatares 3<->4");
+    bench_pagina(NUM_ZONAS, "desenhar_tela medidor fixa",  "desenhar_tela medidor +-1");
+
+    bench_encerrar();
+}
+#endif
+
 /* --------------------------------------------------------------------------- */
 /* 10. Configuração inicial (main)                                             */
 /* --------------------------------------------------------------------------- */
@@ -315,9 +1105,12 @@ int main(void)
 
     ssd1306_init(&oled, OLED_LARGURA, OLED_ALTURA, false, OLED_ENDERECO, I2C_PORT);
     ssd1306_config(&oled);
+    ssd1306_dma_init(&oled);
 
     /* Matriz 5×5 */
     inicializar_matriz_led();
+    matriz_cache_occupancy(paleta_ocupacao);
+    matriz_set_callback(matriz_quadro_exibido, NULL);
 
     /* LEDs */
     gpio_init(PINO_LED_VERDE);    gpio_set_dir(PINO_LED_VERDE, GPIO_OUT);
@@ -335,32 +1128,68 @@ int main(void)
     pwm_set_chan_level(slice_buzzer, channel_buzzer, wrap / 2); /* 50 % duty */
     pwm_set_enabled(slice_buzzer, false);                 /* inicia desligado */
 
-    /* Botões / Joystick */
+    /* Botões / Joystick (IRQs habilitadas após criar as tasks) */
     gpio_init(PINO_BTN_ENTRADA);  gpio_set_dir(PINO_BTN_ENTRADA, GPIO_IN); gpio_pull_up(PINO_BTN_ENTRADA);
     gpio_init(PINO_BTN_SAIDA);    gpio_set_dir(PINO_BTN_SAIDA,   GPIO_IN); gpio_pull_up(PINO_BTN_SAIDA);
 
     gpio_init(PINO_JOYSTICK_RESET);
     gpio_set_dir(PINO_JOYSTICK_RESET, GPIO_IN); gpio_pull_up(PINO_JOYSTICK_RESET);
-    gpio_set_irq_enabled_with_callback(PINO_JOYSTICK_RESET, GPIO_IRQ_EDGE_FALL, true, &irq_joystick);
 
     /* Sincronização */
-    mtx_usuarios  = xSemaphoreCreateMutex();
-    mtx_oled      = xSemaphoreCreateMutex();
-    sem_reset_irq = xSemaphoreCreateBinary();
-    sem_vagas     = xSemaphoreCreateCounting(MAX_USUARIOS, MAX_USUARIOS);
-    fila_display  = xQueueCreate(TAM_FILA_DISPLAY, sizeof(comando_display_t));
+    mtx_oled      = xSemaphoreCreateMutexStatic(&mtx_oled_mem);
+    sem_reset_irq = xSemaphoreCreateBinaryStatic(&sem_reset_irq_mem);
+    for (int i = 0; i < NUM_ZONAS; ++i) zona_init(&zonas[i], zonas_cfg[i].nome, zonas_cfg[i].capacidade);
+    if (!layout_flash_livre())                     // imagem grande demais: o log apagaria o código
+        panic("Firmware invade a regiao de log/contadores da flash");
+    eventos_init();                                // continua após o setor mais novo da flash
 
-    configASSERT(mtx_usuarios && mtx_oled && sem_reset_irq && sem_vagas && fila_display);
+    /* Contadores salvos: resets e ocupação de cada zona sobrevivem ao reboot */
+    contadores_init();
+    total_resets = contadores_ler(CONT_RESETS);
+    for (int i = 0; i < NUM_ZONAS; ++i) zona_restaurar(&zonas[i], contadores_ler(CONT_OCUPACAO(i)));
+    painel_publicar();                             // retrato inicial para o 1º quadro
 
-    /* UI inicial */
-    desenhar_tela();
+    configASSERT(mtx_oled && sem_reset_irq);
 
+#if PAINEL_BENCH
+    TASK_ESTATICA(bench, 2 * PILHA_TASK);
+    xTaskCreateStatic(task_bench, "Bench", PALAVRAS(pilha_bench), NULL, 2, pilha_bench, &tcb_bench);
+#else
     /* Tasks */
-    xTaskCreate(task_entrada,        "Entrada",      1024, NULL, 2, NULL);
-    xTaskCreate(task_saida,          "Saida",        1024, NULL, 2, NULL);
-    xTaskCreate(task_reset,          "Reset",        1024, NULL, 3, NULL);
-    xTaskCreate(task_alternar_tela,  "AlternarTela", 1024, NULL, 1, NULL);
-    xTaskCreate(task_display,        "Display",      1024, NULL, 2, NULL);
+    TASK_ESTATICA(botoes,     PILHA_TASK);
+    TASK_ESTATICA(reset,      PILHA_TASK);
+    TASK_ESTATICA(alternar,   PILHA_TASK);
+    TASK_ESTATICA(display,    PILHA_TASK);
+    TASK_ESTATICA(telemetria, PILHA_TASK);
+    TASK_ESTATICA(flash,      PILHA_TASK);
+    TASK_ESTATICA(carga,      PILHA_TASK);
+
+    TaskHandle_t tarefa_reset, tarefa_telemetria, tarefa_flash;
+    tarefa_botoes     = xTaskCreateStatic(task_botoes,        "Botoes",       PALAVRAS(pilha_botoes),     NULL, 2, pilha_botoes,     &tcb_botoes);
+    tarefa_reset      = xTaskCreateStatic(task_reset,         "Reset",        PALAVRAS(pilha_reset),      NULL, 3, pilha_reset,      &tcb_reset);
+    tarefa_alternar   = xTaskCreateStatic(task_alternar_tela, "AlternarTela", PALAVRAS(pilha_alternar),   NULL, 1, pilha_alternar,   &tcb_alternar);
+    tarefa_display    = xTaskCreateStatic(task_display,       "Display",      PALAVRAS(pilha_display),    NULL, 2, pilha_display,    &tcb_display);
+    tarefa_telemetria = xTaskCreateStatic(task_telemetria,    "Telemetria",   PALAVRAS(pilha_telemetria), NULL, 1, pilha_telemetria, &tcb_telemetria);
+    tarefa_flash      = xTaskCreateStatic(task_flash,         "Flash",        PALAVRAS(pilha_flash),      NULL, 1, pilha_flash,      &tcb_flash);
+    tarefa_carga      = xTaskCreateStatic(task_carga,         "Carga",        PALAVRAS(pilha_carga),      NULL, 2, pilha_carga,      &tcb_carga);
+
+#if configNUM_CORES > 1
+    vTaskCoreAffinitySet(tarefa_botoes,   NUCLEO_ENTRADA);
+    vTaskCoreAffinitySet(tarefa_reset,    NUCLEO_ENTRADA);
+    vTaskCoreAffinitySet(tarefa_alternar, NUCLEO_ENTRADA);
+    vTaskCoreAffinitySet(tarefa_display,  NUCLEO_SAIDA);
+    vTaskCoreAffinitySet(tarefa_telemetria, NUCLEO_ENTRADA);
+    vTaskCoreAffinitySet(tarefa_flash,      NUCLEO_ENTRADA);   // flash_safe_execute para o outro núcleo
+    vTaskCoreAffinitySet(tarefa_carga,      NUCLEO_ENTRADA);   // mesma admissão dos botões
+#else
+    (void)tarefa_reset; (void)tarefa_telemetria; (void)tarefa_flash;
+#endif
+
+    /* Interrupções de GPIO: só depois que semáforos e tasks existem */
+    gpio_set_irq_enabled_with_callback(PINO_JOYSTICK_RESET, GPIO_IRQ_EDGE_FALL, true, &irq_gpio);
+    gpio_set_irq_enabled(PINO_BTN_ENTRADA, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    gpio_set_irq_enabled(PINO_BTN_SAIDA,   GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+#endif
 
     vTaskStartScheduler();
     while (1);   /* nunca deve chegar aqui */